@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Physics/World2D.h"
+#include "Utils/Math/Random.h"
+
+// steps canned physics scenes without a window and reports how long each update took.
+// usage: QuasiPhysicsBench [scene...] [--steps N] [--substeps N] [--dt S] [--broadphase sweep|tree|hash]
+//                          [--threads N] [--no-substep-reuse] [--no-sleep] [--seed N] [--csv]
+// scenes: pyramid circles capsules polygons tiles hulls piles, all of them when none are given.
+
+using namespace Quasi;
+using namespace Quasi::Math;
+
+struct BenchOptions {
+    u32 steps = 600, substeps = 4, threads = 0, seed = 1;
+    float dt = 1 / 60.0f;
+    Physics2D::BroadphaseMode broadphase = Physics2D::BroadphaseMode::SORT_AND_SWEEP;
+    bool reuseSubstepPairs = true, allowSleep = true, csv = false;
+};
+
+struct BenchScene {
+    const char* name;
+    void (*build)(Physics2D::World& world, RandomGenerator& rng);
+};
+
+static void AddContainer(Physics2D::World& world, float halfWidth, float height) {
+    world.CreateBody({ .position = { 0, -2 }, .type = Physics2D::BodyType::STATIC }, Physics2D::RectShape { halfWidth + 2, 2 });
+    world.CreateBody({ .position = { -halfWidth - 1, height * 0.5f }, .type = Physics2D::BodyType::STATIC }, Physics2D::RectShape { 1, height * 0.5f });
+    world.CreateBody({ .position = { +halfWidth + 1, height * 0.5f }, .type = Physics2D::BodyType::STATIC }, Physics2D::RectShape { 1, height * 0.5f });
+}
+
+static void BuildPyramid(Physics2D::World& world, RandomGenerator&) {
+    static constexpr u32 BASE = 40;
+    world.CreateBody({ .position = { 0, -2 }, .type = Physics2D::BodyType::STATIC }, Physics2D::RectShape { 200, 2 });
+    for (u32 row = 0; row < BASE; ++row) {
+        for (u32 i = 0; i < BASE - row; ++i) {
+            const float x = ((float)i - (float)(BASE - row - 1) * 0.5f) * 1.05f;
+            world.CreateBody({ .position = { x, 0.5f + (float)row } }, Physics2D::RectShape { 0.5f, 0.5f });
+        }
+    }
+}
+
+static void BuildCircles(Physics2D::World& world, RandomGenerator& rng) {
+    static constexpr u32 COUNT = 10'000, COLUMNS = 200;
+    AddContainer(world, 260, 400);
+    for (u32 i = 0; i < COUNT; ++i) {
+        const fv2 p = { ((float)(i % COLUMNS) - COLUMNS * 0.5f) * 2.5f + rng.Get(-0.2f, 0.2f), 2 + (float)(i / COLUMNS) * 2.5f };
+        world.CreateBody({ .position = p }, Physics2D::CircleShape { rng.Get(0.5f, 1.0f) });
+    }
+}
+
+static void BuildCapsules(Physics2D::World& world, RandomGenerator& rng) {
+    static constexpr u32 COUNT = 2'000, COLUMNS = 50;
+    AddContainer(world, 110, 300);
+    for (u32 i = 0; i < COUNT; ++i) {
+        const fv2 p = { ((float)(i % COLUMNS) - COLUMNS * 0.5f) * 4.0f, 3 + (float)(i / COLUMNS) * 4.0f };
+        const fv2 forward = fv2::FromPolar(rng.Get(0.5f, 1.5f), Radians(rng.Get(0.0f, (float)TAU)));
+        world.CreateBody({ .position = p }, Physics2D::CapsuleShape { forward, rng.Get(0.3f, 0.5f) });
+    }
+}
+
+static void BuildPolygons(Physics2D::World& world, RandomGenerator& rng) {
+    static constexpr u32 COUNT = 2'000, COLUMNS = 50;
+    AddContainer(world, 110, 300);
+    for (u32 i = 0; i < COUNT; ++i) {
+        const fv2 p = { ((float)(i % COLUMNS) - COLUMNS * 0.5f) * 4.0f, 3 + (float)(i / COLUMNS) * 4.0f };
+        // points on a circle in angle order are always convex
+        const u32 n = rng.Get(3u, 9u);
+        float angles[8];
+        for (u32 k = 0; k < n; ++k) angles[k] = rng.Get(0.0f, (float)TAU);
+        std::sort(angles, angles + n);
+        fv2 points[8];
+        const float radius = rng.Get(0.8f, 1.5f);
+        for (u32 k = 0; k < n; ++k) points[k] = fv2::FromPolar(radius, Radians(angles[k]));
+        world.CreatePolygon({ .position = p }, Span<const fv2>::Slice(points, n));
+    }
+}
+
+static void BuildTiles(Physics2D::World& world, RandomGenerator& rng) {
+    static constexpr u32 TILES_X = 500, TILES_Y = 10, COUNT = 300;
+    // a tiled level: lots of small static blocks with a few bodies bouncing around on top
+    for (u32 y = 0; y < TILES_Y; ++y)
+        for (u32 x = 0; x < TILES_X; ++x)
+            world.CreateBody({ .position = { ((float)x - TILES_X * 0.5f) * 1.0f, -(float)y }, .type = Physics2D::BodyType::STATIC }, Physics2D::RectShape { 0.5f, 0.5f });
+    for (u32 i = 0; i < COUNT; ++i) {
+        const fv2 p = { rng.Get(-(float)TILES_X * 0.45f, (float)TILES_X * 0.45f), rng.Get(2.0f, 30.0f) };
+        if (i % 2) world.CreateBody({ .position = p }, Physics2D::CircleShape { rng.Get(0.3f, 0.8f) });
+        else       world.CreateBody({ .position = p }, Physics2D::RectShape { rng.Get(0.3f, 0.8f), rng.Get(0.3f, 0.8f) });
+    }
+}
+
+static void BuildHulls(Physics2D::World& world, RandomGenerator& rng) {
+    static constexpr u32 CHUNKS = 60, COUNT = 1'500, COLUMNS = 50;
+    static constexpr float CHUNK_WIDTH = 8;
+    // terrain made of big convex chunks, with boulders and smaller pieces rolling over it
+    fv2 points[64];
+    for (u32 c = 0; c < CHUNKS; ++c) {
+        const u32 n = rng.Get(32u, 65u);
+        const float height = rng.Get(1.0f, 4.0f);
+        // the top of an ellipse, closed off by the flat bottom between its ends
+        for (u32 k = 0; k < n; ++k)
+            points[k] = fv2::FromPolar(1, Radians((float)PI * (float)k / (float)(n - 1))) * fv2 { CHUNK_WIDTH * 0.5f, height };
+        const float x = ((float)c - CHUNKS * 0.5f) * CHUNK_WIDTH;
+        world.CreatePolygon({ .position = { x, 0 }, .type = Physics2D::BodyType::STATIC }, Span<const fv2>::Slice(points, n));
+    }
+    AddContainer(world, CHUNKS * CHUNK_WIDTH * 0.5f, 300);
+    for (u32 i = 0; i < COUNT; ++i) {
+        const fv2 p = { ((float)(i % COLUMNS) - COLUMNS * 0.5f) * 5.0f, 8 + (float)(i / COLUMNS) * 5.0f };
+        const u32 n = i % 3 ? rng.Get(3u, 9u) : rng.Get(16u, 33u);
+        const float radius = i % 3 ? rng.Get(0.6f, 1.2f) : rng.Get(1.2f, 2.0f);
+        const float offset = rng.Get(0.0f, (float)TAU);
+        for (u32 k = 0; k < n; ++k) points[k] = fv2::FromPolar(radius, Radians(offset + (float)TAU * (float)k / (float)n));
+        world.CreatePolygon({ .position = p }, Span<const fv2>::Slice(points, n));
+    }
+}
+
+static void BuildPiles(Physics2D::World& world, RandomGenerator& rng) {
+    static constexpr u32 PILES = 64, PER_PILE = 60, COLUMNS = 6;
+    static constexpr float SPACING = 20;
+    // lots of separate piles on one floor, each settles as its own island
+    world.CreateBody({ .position = { 0, -2 }, .type = Physics2D::BodyType::STATIC }, Physics2D::RectShape { PILES * SPACING * 0.5f + 10, 2 });
+    for (u32 p = 0; p < PILES; ++p) {
+        const float x = ((float)p - PILES * 0.5f) * SPACING;
+        for (u32 i = 0; i < PER_PILE; ++i) {
+            const fv2 pos = { x + ((float)(i % COLUMNS) - COLUMNS * 0.5f) * 1.1f + rng.Get(-0.05f, 0.05f), 0.5f + (float)(i / COLUMNS) * 1.1f };
+            if (i % 2) world.CreateBody({ .position = pos }, Physics2D::CircleShape { 0.5f });
+            else       world.CreateBody({ .position = pos }, Physics2D::RectShape { 0.5f, 0.5f });
+        }
+    }
+}
+
+static constexpr BenchScene SCENES[] = {
+    { "pyramid",  BuildPyramid  },
+    { "circles",  BuildCircles  },
+    { "capsules", BuildCapsules },
+    { "polygons", BuildPolygons },
+    { "tiles",    BuildTiles    },
+    { "hulls",    BuildHulls    },
+    { "piles",    BuildPiles    },
+};
+
+static u64 StateChecksum(const Physics2D::World& world) {
+    // fnv-1a over the raw bits, so any change in the simulation shows up
+    u64 hash = 14695981039346656037ull;
+    const auto mix = [&] (float f) {
+        const u32 bits = f32s::BitsOf(f);
+        for (u32 b = 0; b < 32; b += 8) {
+            hash ^= bits >> b & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+    for (const Physics2D::Body* b : world.bodies) {
+        mix(b->Position().x);
+        mix(b->Position().y);
+        mix(b->Velocity().x);
+        mix(b->Velocity().y);
+        mix(b->AngularVelocity());
+    }
+    return hash;
+}
+
+static float Percentile(const Vec<float>& sorted, float p) {
+    if (sorted.IsEmpty()) return 0;
+    return sorted[std::min((usize)(p * (float)sorted.Length()), sorted.Length() - 1)];
+}
+
+static void RunScene(const BenchScene& scene, const BenchOptions& options) {
+    Physics2D::World world { { 0, -20.0f } };
+    world.SetBroadphase(options.broadphase);
+    world.SetWorkerThreads(options.threads);
+    world.reuseSubstepPairs = options.reuseSubstepPairs;
+    world.allowSleep = options.allowSleep;
+
+    RandomGenerator rng;
+    rng.SetSeed(options.seed);
+    scene.build(world, rng);
+
+    Vec<float> stepMs;
+    stepMs.Reserve(options.steps);
+    u64 pairs = 0, manifolds = 0, contactPoints = 0, broadphaseRuns = 0;
+    float totalMs = 0;
+    for (u32 i = 0; i < options.steps; ++i) {
+        world.Update(options.dt, (int)options.substeps);
+        const Physics2D::World::Stats& stats = world.GetStats();
+        stepMs.Push(stats.totalMs);
+        totalMs        += stats.totalMs;
+        pairs          += stats.candidatePairs;
+        manifolds      += stats.manifolds;
+        contactPoints  += stats.contactPoints;
+        broadphaseRuns += stats.broadphaseRuns;
+    }
+    const u64 checksum = StateChecksum(world);
+
+    const float steps = (float)std::max(options.steps, 1u);
+    std::sort(stepMs.Data(), stepMs.Data() + stepMs.Length());
+    const float p50 = Percentile(stepMs, 0.5f), p90 = Percentile(stepMs, 0.9f), p99 = Percentile(stepMs, 0.99f),
+                max = stepMs.IsEmpty() ? 0 : stepMs.Last();
+    if (options.csv) {
+        std::printf("%s,%u,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.1f,%.1f,%.1f,%.2f,%016llx\n",
+            scene.name, (u32)world.bodies.Length(), options.steps,
+            totalMs / steps, p50, p90, p99, max,
+            (float)pairs / steps, (float)manifolds / steps, (float)contactPoints / steps,
+            (float)broadphaseRuns / steps, (unsigned long long)checksum);
+    } else {
+        std::printf("%-9s %6u bodies  mean %8.3f  p50 %8.3f  p90 %8.3f  p99 %8.3f  max %8.3f ms\n"
+                    "%-9s pairs %.1f  manifolds %.1f  contact points %.1f  broadphase runs %.2f per update  checksum %016llx\n",
+            scene.name, (u32)world.bodies.Length(), totalMs / steps, p50, p90, p99, max,
+            "", (float)pairs / steps, (float)manifolds / steps, (float)contactPoints / steps,
+            (float)broadphaseRuns / steps, (unsigned long long)checksum);
+    }
+}
+
+static bool ParseBroadphase(const char* name, Physics2D::BroadphaseMode& out) {
+    if (!std::strcmp(name, "sweep")) { out = Physics2D::BroadphaseMode::SORT_AND_SWEEP; return true; }
+    if (!std::strcmp(name, "tree"))  { out = Physics2D::BroadphaseMode::DYNAMIC_TREE;   return true; }
+    if (!std::strcmp(name, "hash"))  { out = Physics2D::BroadphaseMode::SPATIAL_HASH;   return true; }
+    return false;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    Vec<const BenchScene*> chosen;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if      (!std::strcmp(arg, "--steps")    && hasValue) options.steps    = (u32)std::atoi(argv[++i]);
+        else if (!std::strcmp(arg, "--substeps") && hasValue) options.substeps = (u32)std::max(std::atoi(argv[++i]), 1);
+        else if (!std::strcmp(arg, "--threads")  && hasValue) options.threads  = (u32)std::atoi(argv[++i]);
+        else if (!std::strcmp(arg, "--seed")     && hasValue) options.seed     = (u32)std::atoi(argv[++i]);
+        else if (!std::strcmp(arg, "--dt")       && hasValue) options.dt       = (float)std::atof(argv[++i]);
+        else if (!std::strcmp(arg, "--broadphase") && hasValue) {
+            if (!ParseBroadphase(argv[++i], options.broadphase)) {
+                std::fprintf(stderr, "unknown broadphase '%s', expected sweep, tree or hash\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (!std::strcmp(arg, "--no-substep-reuse")) options.reuseSubstepPairs = false;
+        else if (!std::strcmp(arg, "--no-sleep"))         options.allowSleep = false;
+        else if (!std::strcmp(arg, "--csv"))              options.csv = true;
+        else {
+            const BenchScene* scene = nullptr;
+            for (const BenchScene& s : SCENES)
+                if (!std::strcmp(arg, s.name)) scene = &s;
+            if (!scene) {
+                std::fprintf(stderr, "unknown argument '%s'\n", arg);
+                return 1;
+            }
+            chosen.Push(scene);
+        }
+    }
+    if (chosen.IsEmpty())
+        for (const BenchScene& s : SCENES) chosen.Push(&s);
+
+    if (options.csv)
+        std::printf("scene,bodies,steps,mean_ms,p50_ms,p90_ms,p99_ms,max_ms,pairs,manifolds,contact_points,broadphase_runs,checksum\n");
+    for (const BenchScene* scene : chosen) RunScene(*scene, options);
+}
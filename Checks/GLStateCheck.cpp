@@ -0,0 +1,159 @@
+#include <cstdio>
+#include <cstring>
+
+#include "Graphics/GLs/GLState.h"
+#include "Graphics/GLs/Shader.h"
+
+// runs GLState and Shader uniforms against a dispatch that only records calls, so the cache can be checked
+// without a window or a gpu. prints every check and exits with 1 if any of them failed.
+
+using namespace Quasi;
+using namespace Quasi::Graphics;
+
+// the gl enums used below, so this doesnt need the gl headers
+static constexpr u32 ARRAY_BUFFER = 0x8892, ELEMENT_ARRAY_BUFFER = 0x8893, TEXTURE_2D = 0x0DE1, DEPTH_TEST = 0x0B71;
+
+struct RecordedCalls {
+    u32 useProgram, bindVertexArray, bindBuffer, activeTexture, bindTexture, enable, disable, uniformLocation, uniform;
+};
+static RecordedCalls calls {};
+
+static GLDispatch Recording() {
+    return {
+        .useProgram      = [] (GraphicsID)              { ++calls.useProgram; },
+        .bindVertexArray = [] (GraphicsID)              { ++calls.bindVertexArray; },
+        .bindBuffer      = [] (u32, GraphicsID)         { ++calls.bindBuffer; },
+        .activeTexture   = [] (u32)                     { ++calls.activeTexture; },
+        .bindTexture     = [] (u32, GraphicsID)         { ++calls.bindTexture; },
+        .enable          = [] (u32)                     { ++calls.enable; },
+        .disable         = [] (u32)                     { ++calls.disable; },
+        // every name gets its own location, as long as they differ in length
+        .uniformLocation = [] (GraphicsID, const char* name) { ++calls.uniformLocation; return (int)std::strlen(name); },
+        .uniform         = [] (int, ShaderUniformType, u32, const void*) { ++calls.uniform; },
+    };
+}
+
+static u32 failures = 0;
+
+static void Check(bool passed, const char* what) {
+    std::printf("%s %s\n", passed ? "ok  " : "FAIL", what);
+    failures += !passed;
+}
+
+static void Reset(GLState& state) {
+    state.UseDispatch(Recording());
+    state.NextFrame();
+    calls = {};
+}
+
+static void CheckPrograms(GLState& state) {
+    Reset(state);
+    state.UseProgram(1);
+    state.UseProgram(1);
+    state.UseProgram(1);
+    state.UseProgram(2);
+    Check(calls.useProgram == 2, "rebinding the same program is skipped");
+    Check(state.GetCounters().issued == 2 && state.GetCounters().skipped == 2, "program binds are counted");
+
+    state.ForgetProgram(2);
+    state.UseProgram(2);
+    Check(calls.useProgram == 3, "a deleted program is bound again");
+
+    state.Invalidate();
+    state.UseProgram(2);
+    Check(calls.useProgram == 4, "nothing is skipped after Invalidate");
+}
+
+static void CheckBuffers(GLState& state) {
+    Reset(state);
+    state.BindVertexArray(1);
+    state.BindVertexArray(1);
+    state.BindBuffer(ARRAY_BUFFER, 5);
+    state.BindBuffer(ARRAY_BUFFER, 5);
+    state.BindBuffer(ELEMENT_ARRAY_BUFFER, 6);
+    state.BindBuffer(ELEMENT_ARRAY_BUFFER, 6);
+    Check(calls.bindVertexArray == 1 && calls.bindBuffer == 2, "rebinding the same vertex array or buffer is skipped");
+
+    state.BindVertexArray(2);
+    state.BindBuffer(ELEMENT_ARRAY_BUFFER, 6);
+    state.BindBuffer(ARRAY_BUFFER, 5);
+    Check(calls.bindBuffer == 3, "a new vertex array resets the element buffer, but not the array buffer");
+
+    state.BindBuffer(ELEMENT_ARRAY_BUFFER, 7);
+    state.ForgetVertexArray(2);
+    state.BindBuffer(ELEMENT_ARRAY_BUFFER, 7);
+    Check(calls.bindBuffer == 5, "deleting the bound vertex array resets the element buffer");
+    state.BindVertexArray(2);
+    Check(calls.bindVertexArray == 3, "a deleted vertex array is bound again");
+
+    state.ForgetBuffer(5);
+    state.BindBuffer(ARRAY_BUFFER, 5);
+    Check(calls.bindBuffer == 6, "a deleted buffer is bound again");
+    Check(state.GetCounters().issued == 9 && state.GetCounters().skipped == 4, "buffer binds are counted");
+}
+
+static void CheckTextures(GLState& state) {
+    Reset(state);
+    state.ActivateSlot(0);
+    state.BindTexture(TEXTURE_2D, 4);
+    state.BindTexture(TEXTURE_2D, 4);
+    Check(calls.activeTexture == 1 && calls.bindTexture == 1, "rebinding the same texture is skipped");
+
+    state.ActivateSlot(1);
+    state.BindTexture(TEXTURE_2D, 4);
+    state.ActivateSlot(0);
+    state.BindTexture(TEXTURE_2D, 4);
+    Check(calls.activeTexture == 3 && calls.bindTexture == 2, "textures are kept per slot");
+
+    state.ForgetTexture(4);
+    state.BindTexture(TEXTURE_2D, 4);
+    state.ActivateSlot(1);
+    state.BindTexture(TEXTURE_2D, 4);
+    Check(calls.bindTexture == 4, "a deleted texture is bound again in every slot");
+}
+
+static void CheckCapabilities(GLState& state) {
+    Reset(state);
+    state.SetCapability(DEPTH_TEST, true);
+    state.SetCapability(DEPTH_TEST, true);
+    state.SetCapability(DEPTH_TEST, false);
+    state.SetCapability(DEPTH_TEST, false);
+    Check(calls.enable == 1 && calls.disable == 1, "toggling a capability to what it already is is skipped");
+    Check(state.GetCounters().issued == 2 && state.GetCounters().skipped == 2, "capability toggles are counted");
+}
+
+static void CheckUniforms(GLState& state) {
+    Reset(state);
+    Shader shader = ShaderProgram { 9 };
+    shader.SetUniformFloat("u_a", 1.0f);
+    shader.SetUniformFloat("u_a", 1.0f);
+    shader.SetUniformFloat("u_a", 2.0f);
+    Check(calls.uniform == 2, "writing a uniform's current value is skipped");
+
+    shader.SetUniformMat4x4("u_bb", Math::Matrix3D::Identity());
+    shader.SetUniformMat4x4("u_bb", Math::Matrix3D::Identity());
+    const float xs[] = { 1, 2, 3 };
+    shader.SetUniformFloatArr("u_ccc", xs);
+    shader.SetUniformFloatArr("u_ccc", Span { xs }.First(2));
+    Check(calls.uniform == 5, "arrays and matrices are compared by value, including their length");
+    Check(calls.uniformLocation == 3, "uniform locations are only looked up once per name");
+    Check(state.GetCounters().issued == 5 && state.GetCounters().skipped == 2, "uniform writes are counted");
+
+    state.NextFrame();
+    Check(state.GetLastFrameCounters().issued == 5 && state.GetCounters().issued == 0, "NextFrame keeps the last frame's totals");
+
+    // theres no real program behind it to delete
+    shader.rendererID = GraphicsNoID;
+}
+
+int main() {
+    GLState& state = GLState::Current();
+    CheckPrograms(state);
+    CheckBuffers(state);
+    CheckTextures(state);
+    CheckCapabilities(state);
+    CheckUniforms(state);
+
+    std::printf("%u check(s) failed\n", failures);
+    return failures ? 1 : 0;
+}
@@ -29,7 +29,8 @@ namespace Quasi::Graphics {
         void Bind() const { G::BindObject(rendererID); }
         void Unbind() const { G::UnbindObject(); }
 
-        void Destroy() { G::DestroyObject(rendererID); rendererID = GraphicsNoID; }
+        // null objects have nothing to delete, gl would ignore it anyways
+        void Destroy() { if (!IsNull()) G::DestroyObject(rendererID); rendererID = GraphicsNoID; }
 
         bool IsNull() const { return rendererID == GraphicsNoID; }
 
@@ -0,0 +1,169 @@
+﻿#include "GLState.h"
+
+#include <glp.h>
+#include "GLDebug.h"
+#include "Shader.h"
+
+namespace Quasi::Graphics {
+    static void UniformGL(int location, ShaderUniformType type, u32 count, const void* data) {
+        using enum ShaderUniformType;
+        const auto* f = (const float*)data;
+        const auto* i = (const int*)data;
+        const auto* u = (const uint*)data;
+        // single values go through the array versions too, with a count of 1
+        switch ((ShaderUniformType)((int)type & ~(int)F_ARRAY)) {
+            case F_UNIT:   QGLCall$(GL::Uniform1fv (location, count, f)); return;
+            case FV2:      QGLCall$(GL::Uniform2fv (location, count, f)); return;
+            case FV3:      QGLCall$(GL::Uniform3fv (location, count, f)); return;
+            case FV4:      QGLCall$(GL::Uniform4fv (location, count, f)); return;
+            case I_UNIT:   QGLCall$(GL::Uniform1iv (location, count, i)); return;
+            case IV2:      QGLCall$(GL::Uniform2iv (location, count, i)); return;
+            case IV3:      QGLCall$(GL::Uniform3iv (location, count, i)); return;
+            case IV4:      QGLCall$(GL::Uniform4iv (location, count, i)); return;
+            case U_UNIT:   QGLCall$(GL::Uniform1uiv(location, count, u)); return;
+            case UV2:      QGLCall$(GL::Uniform2uiv(location, count, u)); return;
+            case UV3:      QGLCall$(GL::Uniform3uiv(location, count, u)); return;
+            case UV4:      QGLCall$(GL::Uniform4uiv(location, count, u)); return;
+            case FMAT_2X2: QGLCall$(GL::UniformMatrix2fv  (location, count, false, f)); return;
+            case FMAT_2X3: QGLCall$(GL::UniformMatrix2x3fv(location, count, false, f)); return;
+            case FMAT_2X4: QGLCall$(GL::UniformMatrix2x4fv(location, count, false, f)); return;
+            case FMAT_3X2: QGLCall$(GL::UniformMatrix3x2fv(location, count, false, f)); return;
+            case FMAT_3X3: QGLCall$(GL::UniformMatrix3fv  (location, count, false, f)); return;
+            case FMAT_3X4: QGLCall$(GL::UniformMatrix3x4fv(location, count, false, f)); return;
+            case FMAT_4X2: QGLCall$(GL::UniformMatrix4x2fv(location, count, false, f)); return;
+            case FMAT_4X3: QGLCall$(GL::UniformMatrix4x3fv(location, count, false, f)); return;
+            case FMAT_4X4: QGLCall$(GL::UniformMatrix4fv  (location, count, false, f)); return;
+            default: return;
+        }
+    }
+
+    GLDispatch GLDispatch::OpenGL() {
+        return {
+            .useProgram      = [] (GraphicsID program)               { QGLCall$(GL::UseProgram(program)); },
+            .bindVertexArray = [] (GraphicsID array)                 { QGLCall$(GL::BindVertexArray(array)); },
+            .bindBuffer      = [] (u32 target, GraphicsID buffer)    { QGLCall$(GL::BindBuffer(target, buffer)); },
+            .activeTexture   = [] (u32 slot)                         { QGLCall$(GL::ActiveTexture(GL::TEXTURE0 + slot)); },
+            .bindTexture     = [] (u32 target, GraphicsID texture)   { QGLCall$(GL::BindTexture(target, texture)); },
+            .enable          = [] (u32 capability)                   { QGLCall$(GL::Enable(capability)); },
+            .disable         = [] (u32 capability)                   { QGLCall$(GL::Disable(capability)); },
+            .uniformLocation = [] (GraphicsID program, const char* name) { return QGLCall$(GL::GetUniformLocation(program, name)); },
+            .uniform         = UniformGL,
+        };
+    }
+
+    GLState::GLState(const GLDispatch& dispatch) : dispatch(dispatch) {
+        Invalidate();
+    }
+
+    GLState& GLState::Current() {
+        static GLState state;
+        return state;
+    }
+
+    void GLState::UseDispatch(const GLDispatch& newDispatch) {
+        dispatch = newDispatch;
+        Invalidate();
+    }
+
+    bool GLState::Track(GraphicsID& held, GraphicsID id) {
+        if (held == id) {
+            ++counters.skipped;
+            return false;
+        }
+        held = id;
+        ++counters.issued;
+        return true;
+    }
+
+    u32 GLState::TextureTargetIndex(u32 target) {
+        switch (target) {
+            case GL::TEXTURE_1D:       return 0;
+            case GL::TEXTURE_1D_ARRAY: return 1;
+            case GL::TEXTURE_2D:       return 2;
+            case GL::TEXTURE_2D_ARRAY: return 3;
+            case GL::TEXTURE_3D:       return 4;
+            case GL::TEXTURE_CUBE_MAP: return 5;
+            default:                   return UNKNOWN;
+        }
+    }
+
+    void GLState::UseProgram(GraphicsID id) {
+        if (Track(program, id)) dispatch.useProgram(id);
+    }
+
+    void GLState::BindVertexArray(GraphicsID id) {
+        if (!Track(vertexArray, id)) return;
+        dispatch.bindVertexArray(id);
+        // the element buffer binding belongs to the vertex array
+        elementBuffer = UNKNOWN;
+    }
+
+    void GLState::BindBuffer(u32 target, GraphicsID id) {
+        GraphicsID* held = target == GL::ARRAY_BUFFER ? &arrayBuffer : target == GL::ELEMENT_ARRAY_BUFFER ? &elementBuffer : nullptr;
+        if (!held) ++counters.issued;
+        else if (!Track(*held, id)) return;
+        dispatch.bindBuffer(target, id);
+    }
+
+    void GLState::ActivateSlot(u32 slot) {
+        if (Track(activeSlot, slot)) dispatch.activeTexture(slot);
+    }
+
+    void GLState::BindTexture(u32 target, GraphicsID id) {
+        const u32 t = TextureTargetIndex(target);
+        if (activeSlot >= TEXTURE_SLOTS || t == UNKNOWN) ++counters.issued;
+        else if (!Track(textures[activeSlot][t], id)) return;
+        dispatch.bindTexture(target, id);
+    }
+
+    void GLState::SetCapability(u32 capability, bool enabled) {
+        if (capabilities.Get(capability).HasValueAnd([&] (bool held) { return held == enabled; })) {
+            ++counters.skipped;
+            return;
+        }
+        capabilities[capability] = enabled;
+        ++counters.issued;
+        (enabled ? dispatch.enable : dispatch.disable)(capability);
+    }
+
+    void GLState::SetUniform(Vec<byte>& held, int location, ShaderUniformType type, u32 count, Bytes data) {
+        if (held.AsSpan() == data) {
+            ++counters.skipped;
+            return;
+        }
+        held.Clear();
+        held.Extend(data);
+        ++counters.issued;
+        dispatch.uniform(location, type, count, data.Data());
+    }
+
+    void GLState::ForgetProgram(GraphicsID id) {
+        if (program == id) program = UNKNOWN;
+    }
+
+    void GLState::ForgetVertexArray(GraphicsID id) {
+        if (vertexArray != id) return;
+        // gl falls back to vertex array 0, which has its own element buffer binding
+        vertexArray = UNKNOWN;
+        elementBuffer = UNKNOWN;
+    }
+
+    void GLState::ForgetBuffer(GraphicsID id) {
+        if (arrayBuffer   == id) arrayBuffer   = UNKNOWN;
+        if (elementBuffer == id) elementBuffer = UNKNOWN;
+    }
+
+    void GLState::ForgetTexture(GraphicsID id) {
+        for (auto& slot : textures)
+            for (GraphicsID& texture : slot)
+                if (texture == id) texture = UNKNOWN;
+    }
+
+    void GLState::Invalidate() {
+        program = vertexArray = arrayBuffer = elementBuffer = activeSlot = UNKNOWN;
+        for (auto& slot : textures)
+            for (GraphicsID& texture : slot)
+                texture = UNKNOWN;
+        capabilities.Clear();
+    }
+}
@@ -0,0 +1,77 @@
+﻿#pragma once
+
+#include "GLObject.h"
+#include "Utils/HashMap.h"
+#include "Utils/Span.h"
+#include "Utils/Vec.h"
+
+namespace Quasi::Graphics {
+    enum class ShaderUniformType;
+
+    // the gl calls that change bindings, toggles or uniforms, as plain function pointers.
+    // swapping in a table that records calls instead lets GLState be checked without a gpu
+    struct GLDispatch {
+        void (*useProgram)     (GraphicsID program);
+        void (*bindVertexArray)(GraphicsID array);
+        void (*bindBuffer)     (u32 target, GraphicsID buffer);
+        void (*activeTexture)  (u32 slot); // slot, not GL_TEXTURE0 + slot
+        void (*bindTexture)    (u32 target, GraphicsID texture);
+        void (*enable)         (u32 capability);
+        void (*disable)        (u32 capability);
+        int  (*uniformLocation)(GraphicsID program, const char* name);
+        // writes count values of type to the bound program, single values and arrays alike
+        void (*uniform)        (int location, ShaderUniformType type, u32 count, const void* data);
+
+        static GLDispatch OpenGL();
+    };
+
+    // remembers what is bound so binding the same thing twice never reaches the driver.
+    // anything that changes these bindings behind its back (imgui, raw gl calls) has to Invalidate after
+    class GLState {
+    public:
+        static constexpr u32 TEXTURE_SLOTS = 32, TEXTURE_TARGETS = 6;
+        static constexpr GraphicsID UNKNOWN = ~0u;
+
+        struct Counters {
+            u32 issued = 0, skipped = 0;
+        };
+    private:
+        GLDispatch dispatch;
+        GraphicsID program = UNKNOWN, vertexArray = UNKNOWN, arrayBuffer = UNKNOWN, elementBuffer = UNKNOWN;
+        u32 activeSlot = UNKNOWN;
+        GraphicsID textures[TEXTURE_SLOTS][TEXTURE_TARGETS];
+        HashMap<u32, bool> capabilities;
+        Counters counters, lastFrame;
+
+        bool Track(GraphicsID& held, GraphicsID id);
+        static u32 TextureTargetIndex(u32 target);
+    public:
+        explicit GLState(const GLDispatch& dispatch = GLDispatch::OpenGL());
+
+        // the state every GLObject binds through
+        static GLState& Current();
+        // also forgets everything, since whatever was bound before isnt known to the new dispatch
+        void UseDispatch(const GLDispatch& newDispatch);
+
+        void UseProgram(GraphicsID id);
+        void BindVertexArray(GraphicsID id);
+        void BindBuffer(u32 target, GraphicsID id);
+        void ActivateSlot(u32 slot);
+        void BindTexture(u32 target, GraphicsID id); // into the active slot
+        void SetCapability(u32 capability, bool enabled);
+        int UniformLocation(GraphicsID program, const char* name) { return dispatch.uniformLocation(program, name); }
+        // held is what the uniform at location was last set to, the write only goes through if data is different
+        void SetUniform(Vec<byte>& held, int location, ShaderUniformType type, u32 count, Bytes data);
+
+        // deleting an object unbinds it, and its id may come back from the next Gen*
+        void ForgetProgram(GraphicsID id);
+        void ForgetVertexArray(GraphicsID id);
+        void ForgetBuffer(GraphicsID id);
+        void ForgetTexture(GraphicsID id);
+        void Invalidate();
+
+        const Counters& GetCounters() const { return counters; } // so far this frame
+        const Counters& GetLastFrameCounters() const { return lastFrame; }
+        void NextFrame() { lastFrame = counters; counters = {}; }
+    };
+}
@@ -5,6 +5,7 @@
 #include <glp.h>
 
 #include "GLDebug.h"
+#include "GLState.h"
 
 namespace Quasi::Graphics {
     IndexBuffer::IndexBuffer(GraphicsID id, u32 size) : GLObject(id), bufferSize(size) {}
@@ -18,15 +19,16 @@ namespace Quasi::Graphics {
     }
 
     void IndexBuffer::DestroyObject(GraphicsID id) {
+        GLState::Current().ForgetBuffer(id);
         QGLCall$(GL::DeleteBuffers(1, &id));
     }
 
     void IndexBuffer::BindObject(GraphicsID id) {
-        QGLCall$(GL::BindBuffer(GL::ELEMENT_ARRAY_BUFFER, id));
+        GLState::Current().BindBuffer(GL::ELEMENT_ARRAY_BUFFER, id);
     }
 
     void IndexBuffer::UnbindObject() {
-        QGLCall$(GL::BindBuffer(GL::ELEMENT_ARRAY_BUFFER, 0));
+        GLState::Current().BindBuffer(GL::ELEMENT_ARRAY_BUFFER, 0);
     }
 
     void IndexBuffer::SetData(Span<const u32> data, u32 dOffset) {
@@ -34,7 +36,14 @@ namespace Quasi::Graphics {
         QGLCall$(GL::BufferSubData(GL::ELEMENT_ARRAY_BUFFER, dOffset, data.ByteSize(), data.Data()));
     }
 
-    void IndexBuffer::ClearData() {
+    void IndexBuffer::ClearData(u32 keep) {
+        dataOffset = keep;
+    }
+
+    void IndexBuffer::Resize(u32 size) {
+        Bind();
+        QGLCall$(GL::BufferData(GL::ELEMENT_ARRAY_BUFFER, sizeof(u32) * size, nullptr, GL::DYNAMIC_DRAW));
+        bufferSize = size;
         dataOffset = 0;
     }
 
@@ -21,7 +21,10 @@ namespace Quasi::Graphics {
         void SetData(Span<const u32> data, u32 dOffset = 0);
         void SetData(Span<const TriIndices> data, u32 dOffset = 0) { SetData(data.Transmute<u32>(), dOffset); }
 
-        void ClearData(); // this doesnt actually clear the dataz, just makes it not
+        void ClearData(u32 keep = 0); // this doesnt actually clear the dataz, just makes it not. keeps the first 'keep' indices
+
+        // orphans the old storage for an empty one of this many indices, which has to be filled again
+        void Resize(u32 size);
 
         void AddData(Span<const u32> data);
         void AddData(Span<const TriIndices> data) { AddData(data.Transmute<u32>()); }
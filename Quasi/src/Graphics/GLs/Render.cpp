@@ -1,26 +1,44 @@
 ﻿#include "Render.h"
 #include <glp.h>
 #include "GLDebug.h"
+#include "GLState.h"
 #include "VertexArray.h"
 #include "../RenderData.h"
 
 namespace Quasi::Graphics::Render {
     void Draw(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader) {
+        DrawRange(vertexArr, indexBuff, shader, 0, indexBuff.GetUsedLength());
+    }
+
+    void DrawInstanced(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, int instances) {
+        DrawRangeInstanced(vertexArr, indexBuff, shader, 0, indexBuff.GetUsedLength(), instances);
+    }
+
+    void DrawRange(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, u32 first, u32 count) {
         vertexArr.Bind();
         indexBuff.Bind();
         shader.Bind();
-        QGLCall$(GL::DrawElements(GL::TRIANGLES, (int)indexBuff.GetUsedLength(), GL::UNSIGNED_INT, nullptr));
+        QGLCall$(GL::DrawElements(GL::TRIANGLES, (int)count, GL::UNSIGNED_INT, (const void*)(first * sizeof(u32))));
     }
 
-    void DrawInstanced(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, int instances) {
+    void DrawRangeInstanced(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, u32 first, u32 count, int instances) {
         vertexArr.Bind();
         indexBuff.Bind();
         shader.Bind();
-        QGLCall$(GL::DrawElementsInstanced(GL::TRIANGLES, (int)indexBuff.GetUsedLength(), GL::UNSIGNED_INT, nullptr, instances));
+        QGLCall$(GL::DrawElementsInstanced(GL::TRIANGLES, (int)count, GL::UNSIGNED_INT, (const void*)(first * sizeof(u32)), instances));
+    }
+
+    static void BindRenderData(const RenderData& dat, const Shader& s) {
+        dat.varray.Bind();
+        if (dat.IsStreaming()) dat.istream.Bind();
+        else dat.ibo.Bind();
+        s.Bind();
     }
 
     void Draw(const RenderData& dat, const Shader& s) {
-        Draw(dat.varray, dat.ibo, s);
+        BindRenderData(dat, s);
+        QGLCall$(GL::DrawElementsBaseVertex(GL::TRIANGLES, (int)dat.IndexCount(), GL::UNSIGNED_INT,
+                                            (void*)(dat.FirstIndex() * sizeof(u32)), dat.BaseVertex()));
     }
 
     void Draw(const RenderData& dat) {
@@ -28,7 +46,9 @@ namespace Quasi::Graphics::Render {
     }
 
     void DrawInstanced(const RenderData& dat, const Shader& s, int instances) {
-        DrawInstanced(dat.varray, dat.ibo, s, instances);
+        BindRenderData(dat, s);
+        QGLCall$(GL::DrawElementsInstancedBaseVertex(GL::TRIANGLES, (int)dat.IndexCount(), GL::UNSIGNED_INT,
+                                                     (const void*)(dat.FirstIndex() * sizeof(u32)), instances, dat.BaseVertex()));
     }
 
     void DrawInstanced(const RenderData& dat, int instances) {
@@ -52,11 +72,11 @@ namespace Quasi::Graphics::Render {
     }
 
     void Enable(const Capability cap) {
-        QGLCall$(GL::Enable((int)cap));
+        GLState::Current().SetCapability((int)cap, true);
     }
 
     void Disable(const Capability cap) {
-        QGLCall$(GL::Disable((int)cap));
+        GLState::Current().SetCapability((int)cap, false);
     }
 
     void UseDepthFunc(const CmpOperation op) {
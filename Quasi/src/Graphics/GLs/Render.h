@@ -151,6 +151,9 @@ namespace Quasi::Graphics {
 namespace Quasi::Graphics::Render {
     void Draw(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader);
     void DrawInstanced(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, int instances);
+    void DrawRange(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, u32 first, u32 count);
+    void DrawRangeInstanced(const VertexArray& vertexArr, const IndexBuffer& indexBuff, const Shader& shader, u32 first, u32 count, int instances);
+    // these skip over the retained meshes, which get drawn one by one with their own model matrix
     void Draw(const RenderData& dat, const Shader& s);
     void Draw(const RenderData& dat);
     void DrawInstanced(const RenderData& dat, const Shader& s, int instances);
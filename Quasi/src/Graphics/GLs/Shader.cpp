@@ -4,6 +4,7 @@
 #include "Texture.h"
 #include "Utils/Text.h"
 #include "GLDebug.h"
+#include "GLState.h"
 #include "Utils/Iter/LinesIter.h"
 
 namespace Quasi::Graphics {
@@ -28,19 +29,20 @@ namespace Quasi::Graphics {
     }
 
     void ShaderProgram::DestroyObject(GraphicsID id) {
+        GLState::Current().ForgetProgram(id);
         QGLCall$(GL::DeleteProgram(id));
     }
 
     void ShaderProgram::BindObject(GraphicsID id) {
-        QGLCall$(GL::UseProgram(id));
+        GLState::Current().UseProgram(id);
     }
 
     void ShaderProgram::UnbindObject() {
-        QGLCall$(GL::UseProgram(0));
+        GLState::Current().UseProgram(0);
     }
 
     int ShaderProgram::GetUniformLocation(CStr name) const {
-        return QGLCall$(GL::GetUniformLocation(rendererID, name.Data()));
+        return GLState::Current().UniformLocation(rendererID, name.Data());
     }
 
     int Shader::GetUniformLocation(CStr name) {
@@ -53,6 +55,20 @@ namespace Quasi::Graphics {
         return location;
     }
 
+    bool Shader::HasUniform(CStr name) {
+        if (const auto cachedLoc = uniformCache.Get(name))
+            return *cachedLoc != -1;
+
+        const int location = ShaderProgram::GetUniformLocation(name);
+        uniformCache[String { name }] = location;
+        return location != -1;
+    }
+
+    void Shader::WriteUniform(CStr name, ShaderUniformType type, u32 count, Bytes data) {
+        const int location = GetUniformLocation(name);
+        GLState::Current().SetUniform(uniformValues[location], location, type, count, data);
+    }
+
     void Shader::SetUniformDyn(CStr name, ShaderUniformType type, Bytes data) {
         using enum ShaderUniformType;
         switch (type) {
@@ -110,47 +126,47 @@ namespace Quasi::Graphics {
         }
     }
 
-    void Shader::SetUniformFloat(CStr name, float x)                 { GL::Uniform1f(GetUniformLocation(name), x); }
-    void Shader::SetUniformFv2(CStr name, const Math::fv2& v2s) { GL::Uniform2f(GetUniformLocation(name), v2s.x, v2s.y); }
-    void Shader::SetUniformFv3(CStr name, const Math::fv3& v3s) { GL::Uniform3f(GetUniformLocation(name), v3s.x, v3s.y, v3s.z); }
-    void Shader::SetUniformFv4(CStr name, const Math::fv4& v4s) { GL::Uniform4f(GetUniformLocation(name), v4s.x, v4s.y, v4s.z, v4s.w); }
-    void Shader::SetUniformFloatArr(CStr name, Span<const float> xs) { GL::Uniform1fv(GetUniformLocation(name), xs.Length(), xs.Data()); }
-    void Shader::SetUniformFv2Arr(CStr name, Span<const Math::fv2> v2s) { GL::Uniform2fv(GetUniformLocation(name), v2s.Length(), (const float*)v2s.Data()); }
-    void Shader::SetUniformFv3Arr(CStr name, Span<const Math::fv3> v3s) { GL::Uniform3fv(GetUniformLocation(name), v3s.Length(), (const float*)v3s.Data()); }
-    void Shader::SetUniformFv4Arr(CStr name, Span<const Math::fv4> v4s) { GL::Uniform4fv(GetUniformLocation(name), v4s.Length(), (const float*)v4s.Data()); }
-    void Shader::SetUniformInt(CStr name, int x)                     { GL::Uniform1i(GetUniformLocation(name), x); }
-    void Shader::SetUniformIv2(CStr name, const Math::iv2& v2s) { GL::Uniform2i(GetUniformLocation(name), v2s.x, v2s.y); }
-    void Shader::SetUniformIv3(CStr name, const Math::iv3& v3s) { GL::Uniform3i(GetUniformLocation(name), v3s.x, v3s.y, v3s.z); }
-    void Shader::SetUniformIv4(CStr name, const Math::iv4& v4s) { GL::Uniform4i(GetUniformLocation(name), v4s.x, v4s.y, v4s.z, v4s.w); }
-    void Shader::SetUniformIntArr(CStr name, Span<const int> xs)     { GL::Uniform1iv(GetUniformLocation(name), xs.Length(), xs.Data()); }
-    void Shader::SetUniformIv2Arr(CStr name, Span<const Math::iv2> v2s) { GL::Uniform2iv(GetUniformLocation(name), v2s.Length(), (const int*)v2s.Data()); }
-    void Shader::SetUniformIv3Arr(CStr name, Span<const Math::iv3> v3s) { GL::Uniform3iv(GetUniformLocation(name), v3s.Length(), (const int*)v3s.Data()); }
-    void Shader::SetUniformIv4Arr(CStr name, Span<const Math::iv4> v4s) { GL::Uniform4iv(GetUniformLocation(name), v4s.Length(), (const int*)v4s.Data()); }
-    void Shader::SetUniformUint(CStr name, uint x)                   { GL::Uniform1ui(GetUniformLocation(name), x); }
-    void Shader::SetUniformUv2(CStr name, const Math::uv2& v2s) { GL::Uniform2ui(GetUniformLocation(name), v2s.x, v2s.y); }
-    void Shader::SetUniformUv3(CStr name, const Math::uv3& v3s) { GL::Uniform3ui(GetUniformLocation(name), v3s.x, v3s.y, v3s.z); }
-    void Shader::SetUniformUv4(CStr name, const Math::uv4& v4s) { GL::Uniform4ui(GetUniformLocation(name), v4s.x, v4s.y, v4s.z, v4s.w); }
-    void Shader::SetUniformUintArr(CStr name, Span<const uint> xs)   { GL::Uniform1uiv(GetUniformLocation(name), xs.Length(), xs.Data()); }
-    void Shader::SetUniformUv2Arr(CStr name, Span<const Math::uv2> v2s) { GL::Uniform2uiv(GetUniformLocation(name), v2s.Length(), (const uint*)v2s.Data()); }
-    void Shader::SetUniformUv3Arr(CStr name, Span<const Math::uv3> v3s) { GL::Uniform3uiv(GetUniformLocation(name), v3s.Length(), (const uint*)v3s.Data()); }
-    void Shader::SetUniformUv4Arr(CStr name, Span<const Math::uv4> v4s) { GL::Uniform4uiv(GetUniformLocation(name), v4s.Length(), (const uint*)v4s.Data()); }
-
-    void Shader::SetUniformColor(CStr name, const Math::fColor3& color3) { GL::Uniform3f(GetUniformLocation(name), color3.r, color3.g, color3.b); }
-    void Shader::SetUniformColor(CStr name, const Math::fColor&  color)  { GL::Uniform4f(GetUniformLocation(name), color.r, color.g, color.b, color.a); }
+    void Shader::SetUniformFloat(CStr name, float x)                 { WriteUniform(name, ShaderUniformType::F_UNIT, 1, Bytes::BytesOf(x)); }
+    void Shader::SetUniformFv2(CStr name, const Math::fv2& v2s) { WriteUniform(name, ShaderUniformType::FV2, 1, Bytes::BytesOf(v2s)); }
+    void Shader::SetUniformFv3(CStr name, const Math::fv3& v3s) { WriteUniform(name, ShaderUniformType::FV3, 1, Bytes::BytesOf(v3s)); }
+    void Shader::SetUniformFv4(CStr name, const Math::fv4& v4s) { WriteUniform(name, ShaderUniformType::FV4, 1, Bytes::BytesOf(v4s)); }
+    void Shader::SetUniformFloatArr(CStr name, Span<const float> xs) { WriteUniform(name, ShaderUniformType::F_ARRAY, xs.Length(), xs.AsBytes()); }
+    void Shader::SetUniformFv2Arr(CStr name, Span<const Math::fv2> v2s) { WriteUniform(name, ShaderUniformType::FV2_ARRAY, v2s.Length(), v2s.AsBytes()); }
+    void Shader::SetUniformFv3Arr(CStr name, Span<const Math::fv3> v3s) { WriteUniform(name, ShaderUniformType::FV3_ARRAY, v3s.Length(), v3s.AsBytes()); }
+    void Shader::SetUniformFv4Arr(CStr name, Span<const Math::fv4> v4s) { WriteUniform(name, ShaderUniformType::FV4_ARRAY, v4s.Length(), v4s.AsBytes()); }
+    void Shader::SetUniformInt(CStr name, int x)                     { WriteUniform(name, ShaderUniformType::I_UNIT, 1, Bytes::BytesOf(x)); }
+    void Shader::SetUniformIv2(CStr name, const Math::iv2& v2s) { WriteUniform(name, ShaderUniformType::IV2, 1, Bytes::BytesOf(v2s)); }
+    void Shader::SetUniformIv3(CStr name, const Math::iv3& v3s) { WriteUniform(name, ShaderUniformType::IV3, 1, Bytes::BytesOf(v3s)); }
+    void Shader::SetUniformIv4(CStr name, const Math::iv4& v4s) { WriteUniform(name, ShaderUniformType::IV4, 1, Bytes::BytesOf(v4s)); }
+    void Shader::SetUniformIntArr(CStr name, Span<const int> xs)     { WriteUniform(name, ShaderUniformType::I_ARRAY, xs.Length(), xs.AsBytes()); }
+    void Shader::SetUniformIv2Arr(CStr name, Span<const Math::iv2> v2s) { WriteUniform(name, ShaderUniformType::IV2_ARRAY, v2s.Length(), v2s.AsBytes()); }
+    void Shader::SetUniformIv3Arr(CStr name, Span<const Math::iv3> v3s) { WriteUniform(name, ShaderUniformType::IV3_ARRAY, v3s.Length(), v3s.AsBytes()); }
+    void Shader::SetUniformIv4Arr(CStr name, Span<const Math::iv4> v4s) { WriteUniform(name, ShaderUniformType::IV4_ARRAY, v4s.Length(), v4s.AsBytes()); }
+    void Shader::SetUniformUint(CStr name, uint x)                   { WriteUniform(name, ShaderUniformType::U_UNIT, 1, Bytes::BytesOf(x)); }
+    void Shader::SetUniformUv2(CStr name, const Math::uv2& v2s) { WriteUniform(name, ShaderUniformType::UV2, 1, Bytes::BytesOf(v2s)); }
+    void Shader::SetUniformUv3(CStr name, const Math::uv3& v3s) { WriteUniform(name, ShaderUniformType::UV3, 1, Bytes::BytesOf(v3s)); }
+    void Shader::SetUniformUv4(CStr name, const Math::uv4& v4s) { WriteUniform(name, ShaderUniformType::UV4, 1, Bytes::BytesOf(v4s)); }
+    void Shader::SetUniformUintArr(CStr name, Span<const uint> xs)   { WriteUniform(name, ShaderUniformType::U_ARRAY, xs.Length(), xs.AsBytes()); }
+    void Shader::SetUniformUv2Arr(CStr name, Span<const Math::uv2> v2s) { WriteUniform(name, ShaderUniformType::UV2_ARRAY, v2s.Length(), v2s.AsBytes()); }
+    void Shader::SetUniformUv3Arr(CStr name, Span<const Math::uv3> v3s) { WriteUniform(name, ShaderUniformType::UV3_ARRAY, v3s.Length(), v3s.AsBytes()); }
+    void Shader::SetUniformUv4Arr(CStr name, Span<const Math::uv4> v4s) { WriteUniform(name, ShaderUniformType::UV4_ARRAY, v4s.Length(), v4s.AsBytes()); }
+
+    void Shader::SetUniformColor(CStr name, const Math::fColor3& color3) { WriteUniform(name, ShaderUniformType::FV3, 1, Bytes::BytesOf(color3)); }
+    void Shader::SetUniformColor(CStr name, const Math::fColor&  color)  { WriteUniform(name, ShaderUniformType::FV4, 1, Bytes::BytesOf(color)); }
     void Shader::SetUniformTex(CStr name, const TextureBase& texture, TextureTarget target, int slot) {
         texture.Activate(target, slot);
-        GL::Uniform1i(GetUniformLocation(name), slot);
+        SetUniformInt(name, slot);
     }
     
-    void Shader::SetUniformMat2x2Arr(CStr name, Span<const Math::Matrix2x2> mats) { GL::UniformMatrix2fv  (GetUniformLocation(name), mats.Length(), false, (const float*)mats.Data()); }
-    void Shader::SetUniformMat2x3Arr(CStr name, Span<const Math::Matrix2x3> mats) { GL::UniformMatrix2x3fv(GetUniformLocation(name), mats.Length(), false, (const float*)mats.Data()); }
-    void Shader::SetUniformMat2x4Arr(CStr name, Span<const Math::Matrix2x4> mats) { GL::UniformMatrix2x4fv(GetUniformLocation(name), mats.Length(), false, (const float*)mats.Data()); }
-    void Shader::SetUniformMat3x2Arr(CStr name, Span<const Math::Matrix3x2> mats) { GL::UniformMatrix3x2fv(GetUniformLocation(name), mats.Length(), false, (const float*)mats.Data()); }
-    void Shader::SetUniformMat3x3Arr(CStr name, Span<const Math::Matrix3x3> mats) { GL::UniformMatrix3fv  (GetUniformLocation(name), mats.Length(), false, (const float*)mats.Data()); }
-    void Shader::SetUniformMat3x4Arr(CStr name, Span<const Math::Matrix3x4> mats) { GL::UniformMatrix3x4fv(GetUniformLocation(name), mats.Length(), false, (const float*)mats.Data()); }
-    void Shader::SetUniformMat4x2Arr(CStr name, Span<const Math::Matrix4x2> mats) { GL::UniformMatrix4x2fv(GetUniformLocation(name), mats.Length(), false, (const float*)mats.Data()); }
-    void Shader::SetUniformMat4x3Arr(CStr name, Span<const Math::Matrix4x3> mats) { GL::UniformMatrix4x3fv(GetUniformLocation(name), mats.Length(), false, (const float*)mats.Data()); }
-    void Shader::SetUniformMat4x4Arr(CStr name, Span<const Math::Matrix4x4> mats) { GL::UniformMatrix4fv  (GetUniformLocation(name), mats.Length(), false, (const float*)mats.Data()); }
+    void Shader::SetUniformMat2x2Arr(CStr name, Span<const Math::Matrix2x2> mats) { WriteUniform(name, ShaderUniformType::FMAT_2X2, mats.Length(), mats.AsBytes()); }
+    void Shader::SetUniformMat2x3Arr(CStr name, Span<const Math::Matrix2x3> mats) { WriteUniform(name, ShaderUniformType::FMAT_2X3, mats.Length(), mats.AsBytes()); }
+    void Shader::SetUniformMat2x4Arr(CStr name, Span<const Math::Matrix2x4> mats) { WriteUniform(name, ShaderUniformType::FMAT_2X4, mats.Length(), mats.AsBytes()); }
+    void Shader::SetUniformMat3x2Arr(CStr name, Span<const Math::Matrix3x2> mats) { WriteUniform(name, ShaderUniformType::FMAT_3X2, mats.Length(), mats.AsBytes()); }
+    void Shader::SetUniformMat3x3Arr(CStr name, Span<const Math::Matrix3x3> mats) { WriteUniform(name, ShaderUniformType::FMAT_3X3, mats.Length(), mats.AsBytes()); }
+    void Shader::SetUniformMat3x4Arr(CStr name, Span<const Math::Matrix3x4> mats) { WriteUniform(name, ShaderUniformType::FMAT_3X4, mats.Length(), mats.AsBytes()); }
+    void Shader::SetUniformMat4x2Arr(CStr name, Span<const Math::Matrix4x2> mats) { WriteUniform(name, ShaderUniformType::FMAT_4X2, mats.Length(), mats.AsBytes()); }
+    void Shader::SetUniformMat4x3Arr(CStr name, Span<const Math::Matrix4x3> mats) { WriteUniform(name, ShaderUniformType::FMAT_4X3, mats.Length(), mats.AsBytes()); }
+    void Shader::SetUniformMat4x4Arr(CStr name, Span<const Math::Matrix4x4> mats) { WriteUniform(name, ShaderUniformType::FMAT_4X4, mats.Length(), mats.AsBytes()); }
 
     Tuple<Str, Str, Str> ShaderProgram::ParseShader(Str program) {
         Str sources[3];
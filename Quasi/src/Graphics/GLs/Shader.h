@@ -10,6 +10,7 @@
 #include "Utils/Math/Matrix.h"
 #include "Utils/Math/Color.h"
 #include "Utils/HashMap.h"
+#include "Utils/Vec.h"
 
 namespace Quasi::Graphics {
     enum class TextureTarget : int;
@@ -85,8 +86,13 @@ namespace Quasi::Graphics {
 
     class Shader : public ShaderProgram {
         HashMap<String, int> uniformCache;
+        // the last value written to each uniform location, so writing the same value again is skipped
+        HashMap<int, Vec<byte>> uniformValues;
 
         explicit Shader(GraphicsID id);
+
+        // count is how many values of type are in data, GLState skips the write if they're the ones already there
+        void WriteUniform(CStr name, ShaderUniformType type, u32 count, Bytes data);
     public:
         Shader() = default;
         Shader(ShaderProgram&& prog) : ShaderProgram(std::move(prog)) {}
@@ -95,6 +101,7 @@ namespace Quasi::Graphics {
         void SetUniformArgs(const ShaderArgs& args);
 
         int GetUniformLocation(CStr name);
+        bool HasUniform(CStr name); // same as GetUniformLocation, but a missing uniform isnt an error
 
 #pragma region Shader Uniform Types
         void SetUniformFloat(CStr name, float x);
@@ -0,0 +1,101 @@
+﻿#include "StreamBuffer.h"
+
+#include <glp.h>
+
+#include "GLDebug.h"
+#include "GLState.h"
+
+namespace Quasi::Graphics {
+    template <BufferTarget Target>
+    StreamBuffer<Target>::StreamBuffer(GraphicsID id, u32 sectionSize, byte* mapped)
+        : GLObject<StreamBuffer>(id), mapped(mapped), sectionSize(sectionSize) {}
+
+    template <BufferTarget Target>
+    bool StreamBuffer<Target>::IsSupported() {
+        return GL::Supports("GL_ARB_buffer_storage");
+    }
+
+    template <BufferTarget Target>
+    StreamBuffer<Target> StreamBuffer<Target>::New(u32 sectionSize) {
+        GraphicsID id;
+        QGLCall$(GL::GenBuffers(1, &id));
+        BindObject(id);
+        const int flags = GL::MAP_WRITE_BIT | GL::MAP_PERSISTENT_BIT | GL::MAP_COHERENT_BIT;
+        QGLCall$(GL::BufferStorage((int)Target, sectionSize * SECTIONS, nullptr, flags));
+        void* mapped = QGLCall$(GL::MapBufferRange((int)Target, 0, sectionSize * SECTIONS, flags));
+        return StreamBuffer { id, sectionSize, (byte*)mapped };
+    }
+
+    template <BufferTarget Target>
+    void StreamBuffer<Target>::DestroyObject(GraphicsID id) {
+        // deleting the buffer unmaps it too
+        GLState::Current().ForgetBuffer(id);
+        QGLCall$(GL::DeleteBuffers(1, &id));
+    }
+
+    template <BufferTarget Target>
+    void StreamBuffer<Target>::BindObject(GraphicsID id) {
+        GLState::Current().BindBuffer((int)Target, id);
+    }
+
+    template <BufferTarget Target>
+    void StreamBuffer<Target>::UnbindObject() {
+        GLState::Current().BindBuffer((int)Target, 0);
+    }
+
+    template <BufferTarget Target>
+    StreamBuffer<Target>::StreamBuffer(StreamBuffer&& sb) noexcept
+        : GLObject<StreamBuffer>(std::move(sb)), mapped(sb.mapped), sectionSize(sb.sectionSize), section(sb.section), used(sb.used) {
+        Memory::MemCopy(fences, sb.fences, sizeof(fences));
+        Memory::MemSet(sb.fences, 0, sizeof(sb.fences));
+        sb.mapped = nullptr;
+    }
+
+    template <BufferTarget Target>
+    StreamBuffer<Target>& StreamBuffer<Target>::operator=(StreamBuffer&& sb) noexcept {
+        DeleteFences();
+        GLObject<StreamBuffer>::operator=(std::move(sb));
+        mapped = sb.mapped;
+        sectionSize = sb.sectionSize;
+        section = sb.section;
+        used = sb.used;
+        Memory::MemCopy(fences, sb.fences, sizeof(fences));
+        Memory::MemSet(sb.fences, 0, sizeof(sb.fences));
+        sb.mapped = nullptr;
+        return *this;
+    }
+
+    template <BufferTarget Target>
+    void StreamBuffer<Target>::DeleteFences() {
+        for (void*& fence : fences) {
+            if (fence) QGLCall$(GL::DeleteSync((GL::Sync)fence));
+            fence = nullptr;
+        }
+    }
+
+    template <BufferTarget Target>
+    void StreamBuffer<Target>::CopyFrom(const StreamBuffer& other, u32 bytes) {
+        if (!bytes) return;
+        GLState& state = GLState::Current();
+        state.BindBuffer(GL::COPY_READ_BUFFER,  other.rendererID);
+        state.BindBuffer(GL::COPY_WRITE_BUFFER, this->rendererID);
+        QGLCall$(GL::CopyBufferSubData(GL::COPY_READ_BUFFER, GL::COPY_WRITE_BUFFER, other.WriteOffset(), WriteOffset(), bytes));
+    }
+
+    template <BufferTarget Target>
+    void StreamBuffer<Target>::NextSection() {
+        fences[section] = QGLCall$(GL::FenceSync(GL::SYNC_GPU_COMMANDS_COMPLETE, 0));
+        section = (section + 1) % SECTIONS;
+        used = 0;
+        if (GL::Sync fence = (GL::Sync)fences[section]) {
+            GL::Enum status;
+            do status = QGLCall$(GL::ClientWaitSync(fence, GL::SYNC_FLUSH_COMMANDS_BIT, 1'000'000));
+            while (status == GL::TIMEOUT_EXPIRED);
+            QGLCall$(GL::DeleteSync(fence));
+            fences[section] = nullptr;
+        }
+    }
+
+    template class StreamBuffer<BufferTarget::VERTEX>;
+    template class StreamBuffer<BufferTarget::INDEX>;
+}
@@ -0,0 +1,56 @@
+﻿#pragma once
+
+#include "GLObject.h"
+#include "Utils/Span.h"
+
+namespace Quasi::Graphics {
+    enum class BufferTarget {
+        VERTEX = 0x8892,
+        INDEX  = 0x8893,
+    };
+
+    // a buffer that stays mapped for as long as it lives, split into SECTIONS parts which are written one frame after another.
+    // everything written during a frame goes one after another into that frame's part, which gets fenced once the frame is over
+    // and is only handed out again after the gpu is done with it, so meshes can be written straight into it without staging copies
+    // or glBufferSubData stalls
+    template <BufferTarget Target>
+    class StreamBuffer : public GLObject<StreamBuffer<Target>> {
+    public:
+        static constexpr u32 SECTIONS = 3;
+    private:
+        byte* mapped = nullptr;
+        u32 sectionSize = 0, section = 0;
+        u32 used = 0; // how much of the section was already written this frame
+        void* fences[SECTIONS] {}; // GLsync
+
+        explicit StreamBuffer(GraphicsID id, u32 sectionSize, byte* mapped);
+        void DeleteFences();
+    public:
+        StreamBuffer() = default;
+        static bool IsSupported(); // needs ARB_buffer_storage, which is core from 4.4
+        static StreamBuffer New(u32 sectionSize);
+        static void DestroyObject(GraphicsID id);
+        static void BindObject(GraphicsID id);
+        static void UnbindObject();
+
+        StreamBuffer(StreamBuffer&& sb) noexcept;
+        StreamBuffer& operator=(StreamBuffer&& sb) noexcept;
+        ~StreamBuffer() { DeleteFences(); }
+
+        u32 SectionSize() const { return sectionSize; }
+        u32 SectionOffset() const { return section * sectionSize; }
+        // where the next write goes, right after whatever came before it this frame
+        u32 WriteOffset() const { return SectionOffset() + used; }
+        byte* WriteData() const { return mapped + WriteOffset(); }
+        u32 Remaining() const { return sectionSize - used; }
+        void Advance(u32 bytes) { used += bytes; }
+        // copies bytes from other's write offset to this one's. the mapping is write only, so this happens on the gpu
+        void CopyFrom(const StreamBuffer& other, u32 bytes);
+
+        // once per frame: fences the section that frame drew from, then waits until the next one is free to write
+        void NextSection();
+    };
+
+    using VertexStream = StreamBuffer<BufferTarget::VERTEX>;
+    using IndexStream  = StreamBuffer<BufferTarget::INDEX>;
+}
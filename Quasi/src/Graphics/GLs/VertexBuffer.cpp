@@ -3,6 +3,7 @@
 #include <glp.h>
 
 #include "GLDebug.h"
+#include "GLState.h"
 
 namespace Quasi::Graphics {
     VertexBuffer::VertexBuffer(GraphicsID id, u32 size) : GLObject(id), bufferSize(size) {}
@@ -16,15 +17,16 @@ namespace Quasi::Graphics {
     }
 
     void VertexBuffer::DestroyObject(GraphicsID id) {
+        GLState::Current().ForgetBuffer(id);
         QGLCall$(GL::DeleteBuffers(1, &id));
     }
 
     void VertexBuffer::BindObject(GraphicsID id) {
-        QGLCall$(GL::BindBuffer(GL::ARRAY_BUFFER, id));
+        GLState::Current().BindBuffer(GL::ARRAY_BUFFER, id);
     }
 
     void VertexBuffer::UnbindObject() {
-        QGLCall$(GL::BindBuffer(GL::ARRAY_BUFFER, 0));
+        GLState::Current().BindBuffer(GL::ARRAY_BUFFER, 0);
     }
 
     void VertexBuffer::SetDataBytes(Span<const byte> data) {
@@ -32,7 +34,14 @@ namespace Quasi::Graphics {
         QGLCall$(GL::BufferSubData(GL::ARRAY_BUFFER, 0, (int)data.ByteSize(), data.Data()));
     }
 
-    void VertexBuffer::ClearData() {
+    void VertexBuffer::ClearData(u32 keep) {
+        dataOffset = keep;
+    }
+
+    void VertexBuffer::Resize(u32 size) {
+        Bind();
+        QGLCall$(GL::BufferData(GL::ARRAY_BUFFER, size, nullptr, GL::DYNAMIC_DRAW));
+        bufferSize = size;
         dataOffset = 0;
     }
 
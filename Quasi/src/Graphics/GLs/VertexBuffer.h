@@ -22,7 +22,9 @@ namespace Quasi::Graphics {
         template <class T> void SetData(Span<const T> data) { SetDataBytes(data.AsBytes()); }
         template <ContinuousCollectionAny T> void SetData(const T& data) { SetData(data.AsSpan()); }
 
-        void ClearData();
+        void ClearData(u32 keep = 0); // keeps the first 'keep' bytes
+        // orphans the old storage for an empty one of this size, which has to be filled again
+        void Resize(u32 size);
 
         void AddDataBytes(Span<const byte> data);
         template <class T> void AddData(Span<const T> data) { AddDataBytes(data.AsBytes()); }
@@ -0,0 +1,108 @@
+﻿#include "VertexElement.h"
+
+// sse is always there on x64, and on x86 once msvc is told to use it
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define Q_GRAPHICS_SSE 1
+    #include <xmmintrin.h>
+#else
+    #define Q_GRAPHICS_SSE 0
+#endif
+
+namespace Quasi::Graphics {
+    template <class V> static V& MemberAt(byte* first, usize stride, usize i) {
+        return *Memory::TransmutePtr<V>(first + i * stride);
+    }
+    template <class V> static const V& MemberAt(const byte* first, usize stride, usize i) {
+        return *Memory::TransmutePtr<const V>(first + i * stride);
+    }
+
+#if Q_GRAPHICS_SSE
+    static constexpr usize LANES = 4;
+
+    // the member is spread out a stride apart, so every lane picks up one component of one vertex
+    static __m128 Gather(const byte* first, usize stride, usize i, u32 c) {
+        return _mm_setr_ps((&MemberAt<float>(first, stride, i))[c],     (&MemberAt<float>(first, stride, i + 1))[c],
+                           (&MemberAt<float>(first, stride, i + 2))[c], (&MemberAt<float>(first, stride, i + 3))[c]);
+    }
+
+    static void Scatter(byte* first, usize stride, usize i, u32 c, __m128 v) {
+        alignas(16) float lanes[LANES];
+        _mm_store_ps(lanes, v);
+        for (usize k = 0; k < LANES; ++k) (&MemberAt<float>(first, stride, i + k))[c] = lanes[k];
+    }
+
+    // transforms LANES vertices at a time and returns how many it got through, the rest are left for the scalar path.
+    // all lanes are gathered from src before any are scattered, so src and dst may be the same.
+    // each lane does the same operations in the same order as the transform's own methods, so a vertex comes out
+    // the same whichever path it takes. FromZero is for the generic matrix products, which start summing from 0
+    template <u32 D, bool Affine, bool Normalize, bool FromZero, class Mat>
+    static usize TransformLanes(const byte* src, byte* dst, usize stride, usize count, const Mat& m) {
+        __m128 cols[D + 1][D];
+        for (u32 j = 0; j < D + Affine; ++j)
+            for (u32 k = 0; k < D; ++k)
+                cols[j][k] = _mm_set1_ps(m[j][k]);
+
+        usize i = 0;
+        for (; i + LANES <= count; i += LANES) {
+            __m128 in[D], out[D];
+            for (u32 c = 0; c < D; ++c) in[c] = Gather(src, stride, i, c);
+            for (u32 k = 0; k < D; ++k) {
+                __m128 r = _mm_mul_ps(in[0], cols[0][k]);
+                if constexpr (FromZero) r = _mm_add_ps(_mm_setzero_ps(), r);
+                for (u32 j = 1; j < D; ++j) r = _mm_add_ps(r, _mm_mul_ps(in[j], cols[j][k]));
+                if constexpr (Affine) r = _mm_add_ps(r, cols[D][k]);
+                out[k] = r;
+            }
+            if constexpr (Normalize) {
+                __m128 lenSq = _mm_mul_ps(out[0], out[0]);
+                for (u32 k = 1; k < D; ++k) lenSq = _mm_add_ps(lenSq, _mm_mul_ps(out[k], out[k]));
+                const __m128 inv = _mm_div_ps(_mm_set1_ps(1), _mm_sqrt_ps(lenSq));
+                for (u32 k = 0; k < D; ++k) out[k] = _mm_mul_ps(out[k], inv);
+            }
+            for (u32 c = 0; c < D; ++c) Scatter(dst, stride, i, c, out[c]);
+        }
+        return i;
+    }
+#endif
+
+    void TransformPositions(const byte* src, byte* dst, usize stride, usize count, const Math::MatrixTransform2D& transform) {
+        usize i = 0;
+#if Q_GRAPHICS_SSE
+        i = TransformLanes<2, true, false, true>(src, dst, stride, count, transform.transform);
+#endif
+        for (; i < count; ++i) {
+            MemberAt<Math::fv2>(dst, stride, i) = transform.Transform(MemberAt<Math::fv2>(src, stride, i));
+        }
+    }
+
+    void TransformPositions(const byte* src, byte* dst, usize stride, usize count, const Math::MatrixTransform3D& transform) {
+        usize i = 0;
+#if Q_GRAPHICS_SSE
+        // Matrix<4>::Transform is already sse, and starts from the first product
+        i = TransformLanes<3, true, false, false>(src, dst, stride, count, transform.transform);
+#endif
+        for (; i < count; ++i) {
+            MemberAt<Math::fv3>(dst, stride, i) = transform.Transform(MemberAt<Math::fv3>(src, stride, i));
+        }
+    }
+
+    void TransformNormals(const byte* src, byte* dst, usize stride, usize count, const Math::MatrixTransform2D& transform) {
+        usize i = 0;
+#if Q_GRAPHICS_SSE
+        i = TransformLanes<2, false, true, true>(src, dst, stride, count, transform.normalMatrix);
+#endif
+        for (; i < count; ++i) {
+            MemberAt<Math::fv2>(dst, stride, i) = transform.TransformNormal(MemberAt<Math::fv2>(src, stride, i));
+        }
+    }
+
+    void TransformNormals(const byte* src, byte* dst, usize stride, usize count, const Math::MatrixTransform3D& transform) {
+        usize i = 0;
+#if Q_GRAPHICS_SSE
+        i = TransformLanes<3, false, true, true>(src, dst, stride, count, transform.normalMatrix);
+#endif
+        for (; i < count; ++i) {
+            MemberAt<Math::fv3>(dst, stride, i) = transform.TransformNormal(MemberAt<Math::fv3>(src, stride, i));
+        }
+    }
+}
@@ -16,10 +16,22 @@
         Q_IF_ARGS_ELSE((__VA_ARGS__), (return __VA_ARGS__(_tr);), ( \
             return T { Q_INVOKE(Q_ARGS_SKIP, Q_ITERATE_SEQUENCE(Q_GL_VERTTRANS_IT, MEMBS)) }; \
         ))\
+    } \
+    /* same as Mul on every vertex of src, written to dst (which may be src itself). */ \
+    /* dst is only ever written to, so it can be a write-only mapping */ \
+    static void MulSpan(Quasi::Span<const T> _src, T* _dst, const Math::MatrixTransform##DIM& _tr) { \
+        if (_src.IsEmpty()) return; \
+        Q_IF_ARGS_ELSE((__VA_ARGS__), ( \
+            for (Quasi::usize _i = 0; _i < _src.Length(); ++_i) _dst[_i] = _src[_i].Mul(_tr); \
+        ), ( \
+            Q_ITERATE_SEQUENCE(Q_GL_VERTBATCH_IT, MEMBS) \
+        ))\
     }
 
 #define Q_GL_VERTTRANS_IT(MX) , .Q_ARGS_FIRST MX = Q_GL_VERTTRANS_WHEN_T MX
 #define Q_GL_VERTTRANS_WHEN_T(M, ...) __VA_OPT__(Quasi::Graphics::Transform##__VA_ARGS__ Q_LPAREN() ) M __VA_OPT__(, _tr Q_RPAREN())
+#define Q_GL_VERTBATCH_IT(MX) Q_GL_VERTBATCH_WHEN_T MX
+#define Q_GL_VERTBATCH_WHEN_T(M, ...) Quasi::Graphics::BatchTransform##__VA_ARGS__(_src.Data(), _dst, _src.Length(), &Self::M, _tr);
 #define Q_GL_VERTLAYOUT_IT(X_) , decltype(Self:: Q_ARGS_FIRST X_)
 
 #define QuasiDefineVertex$(...) Q_GL_DEFINE_VERTEX(__VA_ARGS__)
@@ -33,6 +45,31 @@ namespace Quasi::Graphics {
     T TransformNormal(const T& n, const auto& transform) { return transform.TransformNormal(n); }
     template <class T> T&& TransfromCustom(T&& custom) { return (T&&)custom; }
 
+    // transform one fv2 / fv3 member of count vertices from src into dst, the member being a stride apart.
+    // src and dst may be the same, but dst is never read. these run a few vertices at a time with sse,
+    // matching the transform's own methods exactly
+    void TransformPositions(const byte* src, byte* dst, usize stride, usize count, const Math::MatrixTransform2D& transform);
+    void TransformPositions(const byte* src, byte* dst, usize stride, usize count, const Math::MatrixTransform3D& transform);
+    void TransformNormals  (const byte* src, byte* dst, usize stride, usize count, const Math::MatrixTransform2D& transform);
+    void TransformNormals  (const byte* src, byte* dst, usize stride, usize count, const Math::MatrixTransform3D& transform);
+
+    // members without a transform are copied over as is
+    template <class T, class M>
+    void BatchTransform(const T* src, T* dst, usize count, M T::* member, const auto&) {
+        if (src == dst) return;
+        for (usize i = 0; i < count; ++i) dst[i].*member = src[i].*member;
+    }
+    template <class T, class M>
+    void BatchTransformPosition(const T* src, T* dst, usize count, M T::* member, const auto& transform) {
+        TransformPositions(Memory::TransmutePtr<const byte>(&(src->*member)), Memory::TransmutePtr<byte>(&(dst->*member)),
+                           sizeof(T), count, transform);
+    }
+    template <class T, class M>
+    void BatchTransformNormal(const T* src, T* dst, usize count, M T::* member, const auto& transform) {
+        TransformNormals(Memory::TransmutePtr<const byte>(&(src->*member)), Memory::TransmutePtr<byte>(&(dst->*member)),
+                         sizeof(T), count, transform);
+    }
+
     struct Vertex2D {
         Math::fv2 Position;
 
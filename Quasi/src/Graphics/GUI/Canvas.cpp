@@ -2,6 +2,7 @@
 
 #include "glp.h"
 #include "GraphicsDevice.h"
+#include "GLs/GLState.h"
 #include "Fonts/TextAlign.h"
 
 namespace Quasi::Graphics {
@@ -506,8 +507,8 @@ namespace Quasi::Graphics {
         canvas.textures[canvas.usedTextures] = textureID;
         storedPoint.RenderPrim |= UIRender::TEXTURE_ID * (canvas.usedTextures + 1);
 
-        GL::ActiveTexture(GL::TEXTURE0 + canvas.usedTextures);
-        GL::BindTexture(GL::TEXTURE_2D, textureID);
+        GLState::Current().ActivateSlot(canvas.usedTextures);
+        GLState::Current().BindTexture(GL::TEXTURE_2D, textureID);
 
         ++canvas.usedTextures;
     }
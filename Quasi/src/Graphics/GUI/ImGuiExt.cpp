@@ -7,6 +7,7 @@
 #include "Complex.h"
 #include "CameraController3D.h"
 #include "Light.h"
+#include "Physics/World2D.h"
 
 #include "Utils/Math/Transform2D.h"
 #include "Utils/Math/Transform3D.h"
@@ -463,6 +464,37 @@ namespace ImGui {
         TreePop();
     }
 
+    void DisplayPhysicsStats(Q Str title, const Q Physics2D::World& world) {
+        if (!TreeNode(title.Data())) return;
+
+        const Q Physics2D::World::Stats& stats = world.GetStats();
+        Text("%.3f ms over %u steps, %u broadphase runs", stats.totalMs, stats.steps, stats.broadphaseRuns);
+
+        const float total = std::max(stats.totalMs, Q f32s::DELTA);
+        const auto phase = [&] (const char* name, float ms) {
+            char overlay[32];
+            ImFormatString(overlay, sizeof(overlay), "%.3f ms", ms);
+            ProgressBar(ms / total, { GetItemDefaultWidth(), 0 }, overlay);
+            SameLine();
+            TextUnformatted(name);
+        };
+        phase("Integrate",   stats.integrateMs);
+        phase("Broadphase",  stats.broadphaseMs);
+        phase("Narrowphase", stats.narrowphaseMs);
+        phase("Resolve",     stats.resolveMs);
+        phase("Bullets",     stats.bulletMs);
+        phase("Sleep",       stats.sleepMs);
+
+        Separator();
+        Text("Candidate Pairs: %u", stats.candidatePairs);
+        Text("Manifolds: %u (%u points)", stats.manifolds, stats.contactPoints);
+        Text("Solved Contacts: %u (%u islands)", stats.solvedContacts, stats.solverIslands);
+        Text("Max Sweep Active: %u", stats.maxSweepActive);
+        Text("Awake Bodies: %u / %u", stats.awakeBodies, (Q u32)world.bodies.Length());
+        Text("Collision Events: %u", stats.collisionEvents);
+        TreePop();
+    }
+
 #pragma region Instantiations
     template ImGuiDataType ImGuiDataEnum<float> ();
     template ImGuiDataType ImGuiDataEnum<double>();
@@ -15,6 +15,10 @@ namespace Quasi::Graphics {
     class Light;
 }
 
+namespace Quasi::Physics2D {
+    class World;
+}
+
 namespace ImGui {
 #define Q Quasi::
 #define Q_IMGUI_EDITOR(NAME, ...) void NAME(Q Str title, __VA_ARGS__, float width = Q floats::NAN)
@@ -72,6 +76,8 @@ namespace ImGui {
     Q_IMGUI_EDITOR(EditCameraController, Q Graphics::CameraController3D& camera);
     Q_IMGUI_EDITOR(EditLight, Q Graphics::Light& light);
 
+    void DisplayPhysicsStats(Q Str title, const Q Physics2D::World& world);
+
 #undef Q
 #undef Q_IMGUI_EDITOR
 } // ImGui
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include "imgui_impl_opengl3.h"
 #include "GLs/Texture.h"
 #include "GLs/GLDebug.h"
+#include "GLs/GLState.h"
 
 namespace Quasi::Graphics {
     class RenderData;
@@ -77,9 +78,13 @@ namespace Quasi::Graphics {
 
         RenderInMode(renderOptions.renderMode);
 
+        for (RenderHandle& r : renders)
+            r->NextFrame();
+
         ioDevice.Update();
 
         renderOptions.drawCalls = 0;
+        GLState::Current().NextFrame();
     }
 
     void GraphicsDevice::End() {
@@ -94,6 +99,8 @@ namespace Quasi::Graphics {
         glfwPollEvents();
             
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        // imgui binds its own program, buffers and textures
+        GLState::Current().Invalidate();
             
         glfwSwapBuffers(mainWindow);
     }
@@ -126,6 +133,8 @@ namespace Quasi::Graphics {
         if (setDefaultShaderArgs) {
             s.SetUniformMat4x4("u_projection", r.projection);
             s.SetUniformMat4x4("u_view", r.camera);
+            // a retained draw may have left its model matrix behind, but these vertices are already in world space
+            if (s.HasUniform("u_model")) s.SetUniformMat4x4("u_model", Math::Matrix3D::Identity());
         }
         Render::Draw(r, s);
         ++renderOptions.drawCalls;
@@ -137,11 +146,25 @@ namespace Quasi::Graphics {
         if (setDefaultShaderArgs) {
             s.SetUniformMat4x4("u_projection", r.projection);
             s.SetUniformMat4x4("u_view", r.camera);
+            // a retained draw may have left its model matrix behind, but these vertices are already in world space
+            if (s.HasUniform("u_model")) s.SetUniformMat4x4("u_model", Math::Matrix3D::Identity());
         }
         Render::DrawInstanced(r, s, instances);
         ++renderOptions.drawCalls;
     }
 
+    void GraphicsDevice::RenderRetained(RenderData& r, const MeshHandle& mesh, const Math::Matrix3D& model, Shader& s, const ShaderArgs& args, bool setDefaultShaderArgs) {
+        s.Bind();
+        s.SetUniformArgs(args);
+        if (setDefaultShaderArgs) {
+            s.SetUniformMat4x4("u_projection", r.projection);
+            s.SetUniformMat4x4("u_view", r.camera);
+        }
+        s.SetUniformMat4x4("u_model", model);
+        Render::DrawRange(r.varray, r.ibo, s, mesh.indexOffset, mesh.indexCount);
+        ++renderOptions.drawCalls;
+    }
+
     void GraphicsDevice::ClearColor(const Math::fColor& color) {
         Render::SetClearColor(color);
     }
@@ -261,6 +284,9 @@ namespace Quasi::Graphics {
                 tCount += data->ibo.dataOffset / 3;
                 if (ImGui::TreeNode((const void*)(intptr_t)i, "Render #%d", i)) {
                     ImGui::Text("%d Vertices (bytes), %d Triangles", data->vbo.dataOffset, data->ibo.dataOffset / 3);
+                    ImGui::Text("Capacity: %d Vertices (bytes), %d Triangles", (u32)data->VertexCapacity(), (u32)data->IndexCapacity() / 3);
+                    ImGui::Text("Peak: %d Vertices (bytes), %d Triangles, grown %d times",
+                        (u32)data->capacityStats.peakVertexBytes, (u32)data->capacityStats.peakIndices / 3, data->capacityStats.growths);
                     ImGui::Unindent();
 
                     ImGui::TreePop();
@@ -268,6 +294,8 @@ namespace Quasi::Graphics {
             }
             ImGui::Text("Total: %d Vertices (bytes), %d Triangles", vCount, tCount);
             ImGui::Text("Draw Calls: %d", renderOptions.drawCalls);
+            const auto& glCalls = GLState::Current().GetLastFrameCounters();
+            ImGui::Text("State Changes (last frame): %d issued, %d skipped", glCalls.issued, glCalls.skipped);
             ImGui::EndTabItem();
         }
 
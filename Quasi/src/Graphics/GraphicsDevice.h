@@ -26,6 +26,7 @@ namespace Quasi::Graphics {
     };
 
     class GraphicsDevice {
+        // only where renders start, they grow past this when they need to
         static constexpr usize MAX_VERTEX_COUNT = 1024;
         static constexpr usize MAX_INDEX_COUNT = 1024;
 
@@ -87,6 +88,8 @@ namespace Quasi::Graphics {
             RenderInstanced(GetRender(index), instances, args, setDefaultShaderArgs);
         }
 
+        void RenderRetained(RenderData& r, const MeshHandle& mesh, const Math::Matrix3D& model, Shader& s, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true);
+
         void ClearColor(const Math::fColor& color);
 
         bool IsClosed() const { return !mainWindow; }
@@ -28,8 +28,10 @@ namespace Quasi::Graphics {
 
         void AddTo(RenderData& rd) const;
         void CopyTo(RenderData& rd) const {
-            Memory::MemCopy(rd.vertexData.Data() + rd.vertexOffset, vertices.Data(), vertices.ByteSize());
-            Memory::MemCopy(rd.indexData.Data() + rd.indexOffset, indices.Data(), indices.ByteSize());
+            rd.ReserveVertexBytes(vertices.ByteSize());
+            rd.ReserveIndices(indices.Length() * 3);
+            Memory::MemCopy(rd.VertexTarget() + rd.vertexOffset, vertices.Data(), vertices.ByteSize());
+            Memory::MemCopy(rd.IndexTarget() + rd.indexOffset, indices.Data(), indices.ByteSize());
             rd.vertexOffset += vertices.ByteSize();
             rd.indexOffset += indices.Length() * 3;
         }
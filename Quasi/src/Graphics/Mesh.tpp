@@ -3,10 +3,7 @@
 
 namespace Quasi::Graphics {
     template <IVertex Vtx> Mesh<Vtx>& Mesh<Vtx>::EmbedTransform() {
-        const auto transform = modelTransform.TransformMatrix().AsTransform();
-        for (auto& v : vertices) {
-            v = v.Mul(transform);
-        }
+        Vtx::MulSpan(vertices, vertices.Data(), modelTransform.TransformMatrix().AsTransform());
         modelTransform = {};
         return *this;
     }
@@ -15,11 +12,12 @@ namespace Quasi::Graphics {
     template <IVertex Vtx>
     void Mesh<Vtx>::AddTo(RenderData& rd) const {
         rd.PushIndicesOffseted(indices, sizeof(Vtx));
+        rd.ReserveVertexBytes(vertices.ByteSize());
 
-        const auto transform = modelTransform.TransformMatrix().AsTransform();
-        for (const Vtx& v : vertices) {
-            rd.PushVertex(v.Mul(transform));
-        }
+        // transformed straight into the render's buffer, instead of one PushVertex at a time
+        Vtx* dest = Memory::TransmutePtr<Vtx>(rd.VertexTarget() + rd.vertexOffset);
+        Vtx::MulSpan(vertices, dest, modelTransform.TransformMatrix().AsTransform());
+        rd.vertexOffset += vertices.ByteSize();
     }
 
     template <IVertex Vtx>
@@ -28,9 +26,9 @@ namespace Quasi::Graphics {
         const auto mLocal = m.modelTransform.TransformMatrix(),
                    modelInverse = modelTransform.TransformMatrix().InvTRS();
         const auto composition = (modelInverse * mLocal).AsTransform();
-        batch.PushSpan(m.vertices.Iter().Map([&] (const Vtx& v) {
-            return v.Mul(composition);
-        }), m.indices);
+        batch.ResizeV(m.vertices.Length());
+        Vtx::MulSpan(m.vertices, vertices.Data() + batch.iOffset, composition);
+        for (const TriIndices& i : m.indices) batch.PushI(i);
         return *this;
     }
 
@@ -14,6 +14,12 @@ namespace Quasi::Graphics {
 		dest.indexData = std::move(from.indexData);
 		dest.vertexOffset = from.vertexOffset;
 		dest.indexOffset = from.indexOffset;
+		dest.retainedVertexOffset = from.retainedVertexOffset;
+		dest.retainedIndexOffset = from.retainedIndexOffset;
+		dest.vstream = std::move(from.vstream);
+		dest.istream = std::move(from.istream);
+		dest.streamLayout = std::move(from.streamLayout);
+		dest.capacityStats = from.capacityStats;
 
 		dest.device = from.device;
 		from.device = nullptr;
@@ -26,18 +32,95 @@ namespace Quasi::Graphics {
 	}
 
 	void RenderData::PushIndex(TriIndices index) {
-		indexData[indexOffset + 0] = index.i;
-		indexData[indexOffset + 1] = index.j;
-		indexData[indexOffset + 2] = index.k;
+		ReserveIndices(3);
+		u32* out = IndexTarget() + indexOffset;
+		out[0] = index.i;
+		out[1] = index.j;
+		out[2] = index.k;
 		indexOffset += 3;
 	}
 
 	void RenderData::PushIndicesOffseted(Span<const TriIndices> indices, usize objectSize) {
 		const u32 iOff = vertexOffset / objectSize;
+		ReserveIndices(indices.Length() * 3);
 		for (const auto& i : indices)
 			PushIndex(i + iOff);
 	}
 
+	MeshHandle RenderData::Retain(Span<const byte> vertices, usize objectSize, Span<const TriIndices> indices) {
+		GLLogger().Assert(!IsStreaming(), "streaming renders cant retain meshes");
+		Clear();
+		BufferUnload();
+		const MeshHandle handle = { (u32)indexOffset, (u32)indices.Length() * 3 };
+		PushIndicesOffseted(indices, objectSize);
+		ReserveVertexBytes(vertices.ByteSize());
+		Memory::MemCopy(vertexData.Data() + vertexOffset, vertices.Data(), vertices.ByteSize());
+		vertexOffset += vertices.ByteSize();
+		BufferLoad();
+
+		retainedVertexOffset = vertexOffset;
+		retainedIndexOffset = indexOffset;
+		return handle;
+	}
+
+	void RenderData::ReleaseRetained() {
+		retainedVertexOffset = 0;
+		retainedIndexOffset = 0;
+		Clear();
+		BufferUnload();
+	}
+
+	bool RenderData::EnableStreaming(const VertexBufferLayout& layout) {
+		if (IsStreaming()) return true;
+		if (!VertexStream::IsSupported()) return false;
+
+		// the vertex array will read from the stream instead, so whatever was retained is gone
+		ReleaseRetained();
+		istream = IndexStream::New((u32)(indexData.Length() * sizeof(u32)));
+		vstream = VertexStream::New((u32)vertexData.Length());
+		vertexData = ArrayBox<byte> {};
+		indexData = ArrayBox<u32> {};
+		streamLayout = layout;
+		varray.Bind();
+		vstream.Bind();
+		varray.AddBuffer(layout);
+		return true;
+	}
+
+	// sizes stay multiples of the vertex size when doubling, so streamed sections still start on a whole vertex
+	void RenderData::GrowVertices(usize needed) {
+		const usize capacity = std::max(VertexCapacity() * 2, needed);
+		if (IsStreaming()) {
+			// the old stream gets deleted, but gl keeps it alive until the gpu's done with the frames still using it
+			VertexStream grownStream = VertexStream::New((u32)capacity);
+			grownStream.CopyFrom(vstream, (u32)vertexOffset);
+			vstream = std::move(grownStream);
+			varray.Bind();
+			vstream.Bind();
+			varray.AddBuffer(streamLayout);
+		} else {
+			// the gpu side grows on the next BufferLoad
+			ArrayBox<byte> grown = ArrayBox<byte>::AllocateUninit(capacity);
+			Memory::MemCopy(grown.Data(), vertexData.Data(), vertexOffset);
+			vertexData = std::move(grown);
+		}
+		++capacityStats.growths;
+	}
+
+	void RenderData::GrowIndices(usize needed) {
+		const usize capacity = std::max(IndexCapacity() * 2, needed);
+		if (IsStreaming()) {
+			IndexStream grownStream = IndexStream::New((u32)(capacity * sizeof(u32)));
+			grownStream.CopyFrom(istream, (u32)(indexOffset * sizeof(u32)));
+			istream = std::move(grownStream);
+		} else {
+			ArrayBox<u32> grown = ArrayBox<u32>::AllocateUninit(capacity);
+			Memory::MemCopy(grown.Data(), indexData.Data(), indexOffset * sizeof(u32));
+			indexData = std::move(grown);
+		}
+		++capacityStats.growths;
+	}
+
 	void RenderData::Bind() const {
 		varray.Bind();
 		vbo.Bind();
@@ -51,18 +134,39 @@ namespace Quasi::Graphics {
 	}
 
 	void RenderData::BufferUnload() {
-		vbo.ClearData();
-		ibo.ClearData();
+		if (IsStreaming()) {
+			// the last context was already drawn, the next one goes after it
+			vstream.Advance((u32)vertexOffset);
+			istream.Advance((u32)(indexOffset * sizeof(u32)));
+			return;
+		}
+		vbo.ClearData((u32)retainedVertexOffset);
+		ibo.ClearData((u32)retainedIndexOffset);
 	}
 
 	void RenderData::BufferLoad() {
-		vbo.AddDataBytes(vertexData.First(vertexOffset));
-		ibo.AddData     (indexData .First(indexOffset));
+		capacityStats.peakVertexBytes = std::max(capacityStats.peakVertexBytes, vertexOffset);
+		capacityStats.peakIndices     = std::max(capacityStats.peakIndices,     indexOffset);
+		if (IsStreaming()) return; // the mapping is coherent, so everything's already there
+
+		// a buffer that grew gets new storage, and the retained meshes have to go up again with it
+		usize vertexFrom = retainedVertexOffset, indexFrom = retainedIndexOffset;
+		if (vbo.GetLength() < VertexCapacity()) { vbo.Resize((u32)VertexCapacity()); vertexFrom = 0; }
+		if (ibo.GetLength() < IndexCapacity())  { ibo.Resize((u32)IndexCapacity());  indexFrom = 0; }
+		vbo.AddDataBytes(vertexData.Subspan(vertexFrom, vertexOffset - vertexFrom));
+		ibo.AddData     (indexData .Subspan(indexFrom,  indexOffset  - indexFrom));
+	}
+
+	void RenderData::NextFrame() {
+		if (!IsStreaming()) return;
+		vstream.NextSection();
+		istream.NextSection();
+		Clear();
 	}
 
 	void RenderData::Clear() {
-		vertexOffset = 0;
-		indexOffset = 0;
+		vertexOffset = retainedVertexOffset;
+		indexOffset = retainedIndexOffset;
 	}
 
 	void RenderData::Render(Shader& replaceShader, const ShaderArgs& args, bool setDefaultShaderArgs) {
@@ -73,6 +177,10 @@ namespace Quasi::Graphics {
 		device->RenderInstanced(*this, instances, replaceShader, args, setDefaultShaderArgs);
 	}
 
+	void RenderData::RenderRetained(const MeshHandle& mesh, const Math::Matrix3D& model, Shader& replaceShader, const ShaderArgs& args, bool setDefaultShaderArgs) {
+		device->RenderRetained(*this, mesh, model, replaceShader, args, setDefaultShaderArgs);
+	}
+
 	void RenderData::Destroy() {
 		if (device) {
 			OptRef prev = device; // prevent infinte loop: deleterender -> erase renderdata -> destructor
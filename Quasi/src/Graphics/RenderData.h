@@ -3,6 +3,7 @@
 #include "GLs/VertexArray.h"
 #include "GLs/VertexBuffer.h"
 #include "GLs/IndexBuffer.h"
+#include "GLs/StreamBuffer.h"
 #include "GLs/Shader.h"
 #include "GLs/VertexElement.h"
 
@@ -17,6 +18,12 @@ namespace Quasi::Graphics {
 
     template <class>
 	class RenderObject;
+
+	// a mesh uploaded once with RenderObject::Upload. it stays in the buffers across frames,
+	// ahead of whatever gets added between BeginContext and EndContext
+	struct MeshHandle {
+		u32 indexOffset = 0, indexCount = 0;
+	};
     
 	class RenderData {
 	public:
@@ -32,6 +39,19 @@ namespace Quasi::Graphics {
 		usize vertexOffset = 0;
 		ArrayBox<u32> indexData;
 		usize indexOffset = 0;
+		// everything before these was retained, clearing only rewinds this far
+		usize retainedVertexOffset = 0, retainedIndexOffset = 0;
+
+		// only there once streaming is turned on, vertices and indices then go here and the staging arrays are freed
+		VertexStream vstream;
+		IndexStream istream;
+		VertexBufferLayout streamLayout; // a copy, growing the streams has to lay them out again
+
+		// how much of its buffers a render ends up using, so they can be sized up front instead of guessed
+		struct CapacityStats {
+			usize peakVertexBytes = 0, peakIndices = 0;
+			u32 growths = 0;
+		} capacityStats;
 
 		OptRef<GraphicsDevice> device;
 		usize deviceIndex = 0;
@@ -58,11 +78,50 @@ namespace Quasi::Graphics {
 		void PushIndex(TriIndices index);
 		void PushIndicesOffseted(Span<const TriIndices> indices, usize objectSize);
 
+		// copies the vertices in as they are and uploads them right away. drops anything added since the last clear
+		MeshHandle Retain(Span<const byte> vertices, usize objectSize, Span<const TriIndices> indices);
+		void ReleaseRetained(); // every handle given out before this is invalid
+
+		// opt in to writing meshes straight into persistently mapped buffers, ring buffered over a few frames.
+		// gives false and stays as is if the driver cant map buffers like that. retained meshes dont work while streaming,
+		// and a streamed context only lasts until the end of the frame it was written in
+		bool EnableStreaming(const VertexBufferLayout& layout);
+		bool IsStreaming() const { return (bool)vstream; }
+
+		// where the next vertex / index gets written, which is the current frame's section when streaming
+		// where the context gets written, which is after this frame's earlier contexts in the current section when streaming
+		byte* VertexTarget() { return IsStreaming() ? vstream.WriteData() : vertexData.Data(); }
+		u32*  IndexTarget()  { return IsStreaming() ? Memory::TransmutePtr<u32>(istream.WriteData()) : indexData.Data(); }
+		const byte* VertexTarget() const { return IsStreaming() ? vstream.WriteData() : vertexData.Data(); }
+		const u32*  IndexTarget()  const { return IsStreaming() ? Memory::TransmutePtr<u32>(istream.WriteData()) : indexData.Data(); }
+
+		// the range of indices that Render draws, and what they count vertices from
+		u32 FirstIndex() const { return IsStreaming() ? istream.WriteOffset() / (u32)sizeof(u32) : (u32)retainedIndexOffset; }
+		u32 IndexCount() const { return (IsStreaming() ? (u32)indexOffset : ibo.GetUsedLength()) - (u32)retainedIndexOffset; }
+		int BaseVertex() const { return IsStreaming() ? (int)(vstream.WriteOffset() / streamLayout.GetStride()) : 0; }
+
+		// in bytes. a streamed render holds this much per section
+		usize VertexCapacity() const { return IsStreaming() ? vstream.SectionSize() : vertexData.Length(); }
+		usize IndexCapacity()  const { return IsStreaming() ? istream.SectionSize() / sizeof(u32) : indexData.Length(); }
+		// how much the current context can hold, a streamed one only gets what's left of this frame's section
+		usize VertexRoom() const { return IsStreaming() ? vstream.Remaining() : VertexCapacity(); }
+		usize IndexRoom()  const { return IsStreaming() ? istream.Remaining() / sizeof(u32) : IndexCapacity(); }
+		// makes room for this much more, doubling the buffers if it doesnt fit.
+		// anything already written stays where it is relative to the start of the context, but pointers to it dont
+		void ReserveVertexBytes(usize bytes) { if (vertexOffset + bytes > VertexRoom()) GrowVertices(vertexOffset + bytes); }
+		void ReserveIndices(usize count)     { if (indexOffset + count > IndexRoom())   GrowIndices(indexOffset + count); }
+	private:
+		void GrowVertices(usize needed);
+		void GrowIndices(usize needed);
+	public:
+
 		void Bind() const;
 		void Unbind() const;
 
 		void BufferUnload();
 		void BufferLoad();
+		// moves a streaming render on to its next section, the device does this at the start of every frame
+		void NextFrame();
 
 		void Clear();
 		template <class T> void Add(const Mesh<T>& mesh) { mesh.AddTo(*this); }
@@ -75,14 +134,18 @@ namespace Quasi::Graphics {
 		void RenderInstanced(Shader& replaceShader, int instances, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true);
 		void RenderInstanced(int instances, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true) { RenderInstanced(shader, instances, args, setDefaultShaderArgs); }
 
+		// the shader gets the model matrix as 'u_model'
+		void RenderRetained(const MeshHandle& mesh, const Math::Matrix3D& model, Shader& replaceShader, const ShaderArgs& args = {}, bool setDefaultShaderArgs = true);
+
 		friend class GraphicsDevice;
 		template <IVertex T> friend class Mesh;
 		template <class T> friend class RenderObject;
 	};
 
 	template <class T> void RenderData::PushVertex(const T& vertex) {
+		ReserveVertexBytes(sizeof(T));
 		const byte* rawbytes = Memory::TransmutePtr<const byte>(&vertex);
-		Memory::MemCopyNoOverlap(&vertexData[vertexOffset], rawbytes, sizeof(T));
+		Memory::MemCopyNoOverlap(VertexTarget() + vertexOffset, rawbytes, sizeof(T));
 		vertexOffset += sizeof(T);
 	}
 }
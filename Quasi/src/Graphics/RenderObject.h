@@ -51,6 +51,20 @@ namespace Quasi::Graphics {
     	void DrawInstanced(const Mesh<T>& mesh, int instances, const DrawOptions& options = {}) { DrawInstanced({ &mesh }, instances, options); }
     	void DrawInstanced(const CollectionAny auto& meshes, int instances, const DrawOptions& options = {});
 
+    	// static meshes go up once, in their local space, and then get drawn with a model matrix every frame
+    	// without touching their vertices. the shader needs a 'uniform mat4 u_model'.
+    	// uploading throws away anything added since BeginContext, so do it outside of a context
+    	MeshHandle Upload(const Mesh<T>& mesh) {
+    		return rd->Retain(mesh.vertices.AsBytes(), sizeof(T), mesh.indices);
+    	}
+    	void Draw(const MeshHandle& mesh, const Math::Matrix3D& model, const DrawOptions& options = {}) {
+    		rd->RenderRetained(mesh, model, Memory::AsMut(options.shader.UnwrapOr(rd->shader)), options.arguments, options.useDefaultArguments);
+    	}
+    	void ReleaseUploads() { rd->ReleaseRetained(); }
+
+    	// meshes get written straight into gpu memory from then on, see RenderData::EnableStreaming
+    	bool UseStreaming() { return rd->EnableStreaming(VertexLayoutOf<T>()); }
+
     	void BeginContext() { rd->BufferUnload(); rd->Clear(); }
     	void AddMesh(const Mesh<T>& mesh) { rd->Add(mesh); }
     	void AddMeshes(const CollectionAny auto& meshes) { for (const Mesh<T>& m : meshes) rd->Add(m); }
@@ -63,14 +77,14 @@ namespace Quasi::Graphics {
     		void PushV(const T& v) { rd->PushVertex(v); }
     		void ResizeV(u32) const {}
     		void ReserveV(u32) const {}
-    		T& VertAt(u32 i) { return rd->vertexData->Transmute<T>()[i]; }
-    		const T& VertAt(u32 i) const { return rd->vertexData->Transmute<T>()[i]; }
+    		T& VertAt(u32 i) { return Memory::TransmutePtr<T>(rd->VertexTarget())[iOffset + i]; }
+    		const T& VertAt(u32 i) const { return Memory::TransmutePtr<const T>(rd->VertexTarget())[iOffset + i]; }
     		u32 VertCount() const { return rd->vertexOffset / sizeof(T) - iOffset; }
 
     		void ResizeI(u32) const {}
     		void ReserveI(u32) const {}
     		void PushI(u32 i, u32 j, u32 k) { rd->PushIndex({ i + iOffset, j + iOffset, k + iOffset }); }
-    		TriIndices* IndexData() { return Memory::TransmutePtr<TriIndices>(rd->indexData.Data()) + iOffset; }
+    		TriIndices* IndexData() { return Memory::TransmutePtr<TriIndices>(rd->IndexTarget()) + iOffset; }
     	};
 
 		RawBatch NewBatch() { return RawBatch { (u32)(rd->vertexOffset / sizeof(T)), *rd }; }
@@ -4,8 +4,18 @@
 #include "World2D.h"
 
 namespace Quasi::Physics2D {
+    Body::Body(BodyHandle handle, u32 index, const fv2& p, const Rotor2D& r, float m, BodyType type, World& world, Shape shape)
+        : storage(world.storage), handle(handle), index(index), type(type), mass(m), shape(std::move(shape)), world(world) {
+        Position() = p;
+        Rotation() = r;
+        storage->invMasses[index] = m > 0 ? 1 / m : 0;
+        UpdateMotionScales();
+        TryUpdateTransforms();
+    }
+
     void Body::AddMomentum(const fv2& newtonSeconds) {
-        velocity += newtonSeconds * invMass;
+        Velocity() += newtonSeconds * InvMass();
+        Wake();
     }
 
     // void Body::AddForce(const fv2& newton) {
@@ -13,7 +23,8 @@ namespace Quasi::Physics2D {
     // }
 
     void Body::AddAngularMomentum(float angMomentum) {
-        angularVelocity += angMomentum * invInertia;
+        AngularVelocity() += angMomentum * InvInertia();
+        Wake();
     }
 
     // void Body::AddTorque(float torque) {
@@ -26,14 +37,25 @@ namespace Quasi::Physics2D {
     }
 
     void Body::AddVelocityAt(const fv2& absPosition, const fv2& vel) {
-        return AddRelativeVelocity(absPosition - position, vel);
+        return AddRelativeVelocity(absPosition - Position(), vel);
     }
 
     void Body::SetMass(float newMass) {
         inertia *= newMass / mass;
-        invInertia = inertia > 0 ? 1 / inertia : 0;
+        storage->invInertias[index] = inertia > 0 ? 1 / inertia : 0;
         mass = newMass;
-        invMass = mass > 0 ? 1 / mass : 0;
+        storage->invMasses[index] = mass > 0 ? 1 / mass : 0;
+    }
+
+    void Body::Teleport(const fv2& newPosition) {
+        Position() = newPosition;
+        TryUpdateTransforms();
+        Wake();
+    }
+
+    void Body::Teleport(const fv2& newPosition, const Rotor2D& newRotation) {
+        Rotation() = newRotation;
+        Teleport(newPosition);
     }
 
     Manifold Body::CollideWith(const Body& target) const {
@@ -53,27 +75,31 @@ namespace Quasi::Physics2D {
     }
 
     PhysicsTransform Body::GetTransform() const {
-        return { position, rotation };
+        return { Position(), Rotation() };
     }
 
     void Body::Update(float dt) {
-        position += velocity * dt;
-        rotation += Radians(angularVelocity * dt);
+        Position() += Velocity() * dt;
+        Rotation() += Radians(AngularVelocity() * dt);
         TryUpdateTransforms();
     }
 
     void Body::TryUpdateTransforms() {
         if (shapeHasChanged) {
-            baseBoundingBox = shape.ComputeBoundingBox();
+            storage->baseBoxes[index] = shape.ComputeBoundingBox();
             inertia = shape.Inertia() * mass;
-            invInertia = inertia > 0 ? 1 / inertia : 0;
+            storage->invInertias[index] = inertia > 0 ? 1 / inertia : 0;
             shapeHasChanged = false;
         }
-        boundingBox = GetTransform().TransformRect(baseBoundingBox);
+        storage->UpdateBox(index);
+        if (proxyId != DynamicTree::NULL_NODE)
+            world->RefitProxy(*this);
     }
 
     void Body::SetShapeHasChanged() {
         shapeHasChanged = true;
+        TryUpdateTransforms();
+        Wake();
     }
 
     void Body::SetTrigger(TriggerFn trigger) {
@@ -85,7 +111,27 @@ namespace Quasi::Physics2D {
             trigger(*this, other, event);
     }
 
-    fRect2D Body::BoundingBox() const {
-        return boundingBox;
+    void Body::SetType(BodyType newType) {
+        world->SetBodyType(*this, newType);
+        UpdateMotionScales();
+    }
+
+    void Body::SetEnabled(bool isEnabled) {
+        enabled = isEnabled;
+        UpdateMotionScales();
+        world->substepPairsStale = true;
+    }
+
+    void Body::SetBullet(bool isBullet) {
+        if (bullet == isBullet) return;
+        bullet = isBullet;
+        if (isBullet) ++world->bulletCount;
+        else          --world->bulletCount;
+    }
+
+    void Body::UpdateMotionScales() {
+        const bool moves = enabled && awake && !IsStatic();
+        storage->motionScales[index]  = moves ? 1.0f : 0.0f;
+        storage->gravityScales[index] = moves && IsDynamic() ? 1.0f : 0.0f;
     }
 } // Physics2D
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 #include "Collision2D.h"
 
+#include "BodyStorage2D.h"
+#include "DynamicTree2D.h"
 #include "PhysicsTransform2D.h"
 #include "Shape2D.h"
 #include "Utils/Math/Vector.h"
@@ -16,36 +18,59 @@ namespace Quasi::Physics2D {
 
     class World;
 
+    // raised once per pair per world update
     enum class EventType {
-        HIT,
-        ENTER,
-        EXIT
+        HIT,   // touched last update too
+        ENTER, // started touching
+        EXIT   // stopped touching, or one of them was disabled or deleted
     };
 
     using TriggerFn = FuncRef<void(const Body& self, const Body& other, EventType event)>;
 
     class Body {
-    public:
-        fv2 position, velocity;
-        Rotor2D rotation; float angularVelocity = 0.0;
-        float mass = 1.0f, invMass = 1.0f, inertia = 1.0f, invInertia = 1.0f;
-        fRect2D baseBoundingBox;
-        fRect2D boundingBox;
+        // hot state lives in the worlds storage, this object only keeps the rarely touched parts
+        Ref<BodyStorage> storage;
+        BodyHandle handle;
+        u32 index; // dense index into the storage, kept up to date by the world
+
         BodyType type = BodyType::NONE;
         bool enabled = true;
+        // sleeping bodies arent integrated or collided until something wakes them
+        bool awake = true;
+        // fast bullets are swept against the world so they cant tunnel through thin bodies
+        bool bullet = false;
+    public:
+        float mass = 1.0f, inertia = 1.0f;
         bool shapeHasChanged = true;
+        float sleepTime = 0;
+        u32 proxyId = DynamicTree::NULL_NODE;
+        u32 islandId = 0;
 
         Shape shape;
         Ref<World> world;
         TriggerFn trigger = nullptr;
 
-        Body(const fv2& p, const Rotor2D& r, float m, BodyType type, World& world, Shape shape)
-            : position(p), rotation(r), mass(m), invMass(m > 0 ? 1 / m : 0), type(type), shape(std::move(shape)),
-              world(world) { TryUpdateTransforms(); }
-
-        void AddVelocity       (const fv2& vel) { velocity += vel; }
+        Body(BodyHandle handle, u32 index, const fv2& p, const Rotor2D& r, float m, BodyType type, World& world, Shape shape);
+
+        BodyHandle Handle() const { return handle; }
+        u32 Index() const { return index; }
+
+        fv2&       Position()       { return storage->positions[index]; }
+        const fv2& Position() const { return storage->positions[index]; }
+        fv2&       Velocity()       { return storage->velocities[index]; }
+        const fv2& Velocity() const { return storage->velocities[index]; }
+        Rotor2D&       Rotation()       { return storage->rotations[index]; }
+        const Rotor2D& Rotation() const { return storage->rotations[index]; }
+        float& AngularVelocity()       { return storage->angularVelocities[index]; }
+        float  AngularVelocity() const { return storage->angularVelocities[index]; }
+        float InvMass()    const { return storage->invMasses[index]; }
+        float InvInertia() const { return storage->invInertias[index]; }
+        const fRect2D& BaseBoundingBox() const { return storage->baseBoxes[index]; }
+        const fRect2D& BoundingBox()     const { return storage->boxes[index]; }
+
+        void AddVelocity       (const fv2& vel) { Velocity() += vel; Wake(); }
         void AddMomentum       (const fv2& newtonSeconds);
-        void AddAngularVelocity(float angVel) { angularVelocity += angVel; }
+        void AddAngularVelocity(float angVel) { AngularVelocity() += angVel; Wake(); }
         void AddAngularMomentum(float angMomentum);
 
         void AddRelativeVelocity(const fv2& relPosition, const fv2& vel);
@@ -53,7 +78,14 @@ namespace Quasi::Physics2D {
 
         void SetMass(float newMass);
 
-        void Stop() { velocity = 0; angularVelocity = 0; }
+        void Stop() { Velocity() = 0; AngularVelocity() = 0; }
+
+        void Teleport(const fv2& newPosition);
+        void Teleport(const fv2& newPosition, const Rotor2D& newRotation);
+
+        void Wake() { awake = true; sleepTime = 0; UpdateMotionScales(); }
+        void Sleep() { awake = false; Stop(); UpdateMotionScales(); }
+        bool IsAwake() const { return awake; }
 
         Manifold CollideWith(const Body& target) const;
         Manifold CollideWith(const Shape& target, const PhysicsTransform& xf) const;
@@ -68,17 +100,23 @@ namespace Quasi::Physics2D {
         void SetTrigger(TriggerFn trigger);
         void TryCallTrigger(const Body& other, EventType event);
 
+        BodyType GetType() const { return type; }
+        void SetType(BodyType newType);
         bool IsStatic()  const { return type == BodyType::STATIC; }
         bool IsDynamic() const { return type == BodyType::DYNAMIC; }
 
-        void Enable()  { enabled = true; }
-        void Disable() { enabled = false; }
+        void Enable()  { SetEnabled(true); }
+        void Disable() { SetEnabled(false); }
+        bool IsEnabled() const { return enabled; }
 
-        fRect2D BoundingBox() const;
+        void SetBullet(bool isBullet);
+        bool IsBullet() const { return bullet; }
+    private:
+        void SetAwake(bool isAwake) { awake = isAwake; UpdateMotionScales(); }
+        void SetEnabled(bool isEnabled);
+        void UpdateMotionScales();
 
         friend class World;
-        friend void StaticResolve (Body&, Body&, const Manifold&);
-        friend void DynamicResolve(Body&, Body&, const Manifold&);
     };
 
     struct BodyCreateOptions {
@@ -86,5 +124,6 @@ namespace Quasi::Physics2D {
         float rotAngle = 0.0f;
         BodyType type = BodyType::DYNAMIC;
         float density = 1.0f;
+        bool bullet = false;
     };
 } // Physics2D
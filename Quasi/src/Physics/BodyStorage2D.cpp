@@ -0,0 +1,162 @@
+#include "BodyStorage2D.h"
+
+#include "Snapshot2D.h"
+
+namespace Quasi::Physics2D {
+    void BodyStorage::Reserve(usize size) {
+        positions.Reserve(size);
+        velocities.Reserve(size);
+        rotations.Reserve(size);
+        angularVelocities.Reserve(size);
+        invMasses.Reserve(size);
+        invInertias.Reserve(size);
+        baseBoxes.Reserve(size);
+        boxes.Reserve(size);
+        motionScales.Reserve(size);
+        gravityScales.Reserve(size);
+        handleOfDense.Reserve(size);
+    }
+
+    void BodyStorage::Clear() {
+        positions.Clear();
+        velocities.Clear();
+        rotations.Clear();
+        angularVelocities.Clear();
+        invMasses.Clear();
+        invInertias.Clear();
+        baseBoxes.Clear();
+        boxes.Clear();
+        motionScales.Clear();
+        gravityScales.Clear();
+        handleOfDense.Clear();
+        // outstanding handles must stay invalid, so every slot gets a new generation
+        freeHandles.Clear();
+        for (u32 h = 0; h < denseOfHandle.Length(); ++h) {
+            denseOfHandle[h] = NULL_INDEX;
+            ++generations[h];
+            freeHandles.Push(h);
+        }
+    }
+
+    BodyHandle BodyStorage::Allocate() {
+        u32 id;
+        if (freeHandles.IsEmpty()) {
+            id = denseOfHandle.Length();
+            denseOfHandle.Push(NULL_INDEX);
+            generations.Push(0);
+        } else {
+            id = freeHandles.Take();
+        }
+
+        denseOfHandle[id] = Length();
+        handleOfDense.Push(id);
+        positions.Push({});
+        velocities.Push({});
+        rotations.Push({});
+        angularVelocities.Push(0);
+        invMasses.Push(0);
+        invInertias.Push(0);
+        baseBoxes.Push({});
+        boxes.Push({});
+        motionScales.Push(0);
+        gravityScales.Push(0);
+        return { id, generations[id] };
+    }
+
+    void BodyStorage::Remove(u32 index) {
+        const u32 id = handleOfDense[index];
+        denseOfHandle[id] = NULL_INDEX;
+        ++generations[id];
+        freeHandles.Push(id);
+
+        positions.PopUnordered(index);
+        velocities.PopUnordered(index);
+        rotations.PopUnordered(index);
+        angularVelocities.PopUnordered(index);
+        invMasses.PopUnordered(index);
+        invInertias.PopUnordered(index);
+        baseBoxes.PopUnordered(index);
+        boxes.PopUnordered(index);
+        motionScales.PopUnordered(index);
+        gravityScales.PopUnordered(index);
+        handleOfDense.PopUnordered(index);
+        if (index < Length())
+            denseOfHandle[handleOfDense[index]] = index;
+    }
+
+    bool BodyStorage::IsValid(BodyHandle handle) const {
+        return handle.id < generations.Length() && generations[handle.id] == handle.generation &&
+               denseOfHandle[handle.id] != NULL_INDEX;
+    }
+
+    u32 BodyStorage::IndexOf(BodyHandle handle) const {
+        return IsValid(handle) ? denseOfHandle[handle.id] : NULL_INDEX;
+    }
+
+    void BodyStorage::IntegrateVelocities(const fv2& gravity, float dt) {
+        const fv2 dv = gravity * dt;
+        fv2* const vel = velocities.Data();
+        const float* const scale = gravityScales.Data();
+        for (u32 i = 0, n = Length(); i < n; ++i)
+            vel[i] += dv * scale[i];
+    }
+
+    void BodyStorage::IntegratePositions(float dt) {
+        fv2* const pos = positions.Data();
+        const fv2* const vel = velocities.Data();
+        const float* const scale = motionScales.Data();
+        const u32 n = Length();
+        for (u32 i = 0; i < n; ++i)
+            pos[i] += vel[i] * (dt * scale[i]);
+
+        // rotors need a sin and cos, so only pay for the bodies that actually spin
+        for (u32 i = 0; i < n; ++i) {
+            const float dtheta = angularVelocities[i] * dt * motionScales[i];
+            if (dtheta != 0) rotations[i] += Rotor2D { Radians(dtheta) };
+        }
+    }
+
+    void BodyStorage::UpdateBoxes() {
+        // bodies that didnt move keep their box, anything moved outside a step updates its own
+        for (u32 i = 0, n = Length(); i < n; ++i)
+            if (motionScales[i] != 0) UpdateBox(i);
+    }
+
+    void BodyStorage::UpdateBox(u32 index) {
+        boxes[index] = PhysicsTransform { positions[index], rotations[index] }.TransformRect(baseBoxes[index]);
+    }
+
+    void BodyStorage::Save(SnapshotWriter& out) const {
+        out.WriteSpan(positions.AsSpan());
+        out.WriteSpan(velocities.AsSpan());
+        out.WriteSpan(rotations.AsSpan());
+        out.WriteSpan(angularVelocities.AsSpan());
+        out.WriteSpan(invMasses.AsSpan());
+        out.WriteSpan(invInertias.AsSpan());
+        out.WriteSpan(baseBoxes.AsSpan());
+        out.WriteSpan(boxes.AsSpan());
+        out.WriteSpan(motionScales.AsSpan());
+        out.WriteSpan(gravityScales.AsSpan());
+        out.WriteSpan(handleOfDense.AsSpan());
+        out.WriteSpan(denseOfHandle.AsSpan());
+        out.WriteSpan(generations.AsSpan());
+        out.WriteSpan(freeHandles.AsSpan());
+    }
+
+    void BodyStorage::Load(SnapshotReader& in) {
+        in.ReadVec(positions);
+        in.ReadVec(velocities);
+        in.ReadVec(rotations);
+        in.ReadVec(angularVelocities);
+        in.ReadVec(invMasses);
+        in.ReadVec(invInertias);
+        in.ReadVec(baseBoxes);
+        in.ReadVec(boxes);
+        in.ReadVec(motionScales);
+        in.ReadVec(gravityScales);
+        in.ReadVec(handleOfDense);
+        in.ReadVec(denseOfHandle);
+        in.ReadVec(generations);
+        in.ReadVec(freeHandles);
+    }
+} // Physics2D
@@ -0,0 +1,63 @@
+#pragma once
+#include "PhysicsTransform2D.h"
+#include "Utils/Hash.h"
+#include "Utils/Math/Rect.h"
+#include "Utils/Vec.h"
+
+namespace Quasi::Physics2D {
+    class SnapshotWriter;
+    class SnapshotReader;
+
+    // stable name for a body. the generation is bumped every time its slot is reused,
+    // so handles to deleted bodies stop resolving instead of pointing at a newer body.
+    struct BodyHandle {
+        static constexpr u32 NULL_ID = ~0u;
+
+        u32 id = NULL_ID, generation = 0;
+
+        bool IsNull() const { return id == NULL_ID; }
+        operator bool() const { return !IsNull(); }
+        bool operator==(const BodyHandle&) const = default;
+        Hashing::Hash GetHashCode() const { return Hashing::HashCombine(Hashing::HashInt(id), Hashing::HashInt(generation)); }
+    };
+
+    // hot per-body state, laid out as one array per field so the per-step loops stay linear.
+    // bodies are packed densely, removal swaps the last body into the hole.
+    class BodyStorage {
+    public:
+        static constexpr u32 NULL_INDEX = ~0u;
+
+        Vec<fv2> positions, velocities;
+        Vec<Rotor2D> rotations;
+        Vec<float> angularVelocities;
+        Vec<float> invMasses, invInertias;
+        Vec<fRect2D> baseBoxes, boxes;
+        // 1 for bodies that move this step and 0 otherwise, multiplied in so the loops dont branch
+        Vec<float> motionScales, gravityScales;
+    private:
+        Vec<u32> handleOfDense;
+        Vec<u32> denseOfHandle, generations;
+        Vec<u32> freeHandles;
+    public:
+        u32 Length() const { return positions.Length(); }
+        void Reserve(usize size);
+        void Clear();
+
+        // appends a zeroed body at the end and returns its handle
+        BodyHandle Allocate();
+        // removes the body at the dense index by moving the last body into it
+        void Remove(u32 index);
+
+        bool IsValid(BodyHandle handle) const;
+        u32 IndexOf(BodyHandle handle) const; // NULL_INDEX if the handle is stale
+        BodyHandle HandleAt(u32 index) const { return { handleOfDense[index], generations[handleOfDense[index]] }; }
+
+        void IntegrateVelocities(const fv2& gravity, float dt);
+        void IntegratePositions(float dt);
+        void UpdateBoxes();
+        void UpdateBox(u32 index);
+
+        void Save(SnapshotWriter& out) const;
+        void Load(SnapshotReader& in);
+    };
+} // Physics2D
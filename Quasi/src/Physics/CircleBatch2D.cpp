@@ -0,0 +1,119 @@
+#include "CircleBatch2D.h"
+
+#include <xmmintrin.h>
+
+#include "Collision2D.h"
+#include "Shape2D.h"
+
+namespace Quasi::Physics2D {
+    void CircleBatch::Resize(u32 count) {
+        for (Vec<float>* field : { &x1, &y1, &r1, &x2, &y2, &r2, &cos2, &sin2, &hx2, &hy2, &nx, &ny, &depth }) {
+            field->Clear();
+            field->Reserve(count);
+            field->SetLengthUnsafe(count);
+        }
+    }
+
+    void CircleBatch::SetCircle(u32 i, const CircleShape& s1, const fv2& p1, const CircleShape& s2, const fv2& p2) {
+        x1[i] = p1.x; y1[i] = p1.y; r1[i] = s1.radius;
+        x2[i] = p2.x; y2[i] = p2.y; r2[i] = s2.radius;
+    }
+
+    void CircleBatch::SetRect(u32 i, const CircleShape& s1, const PhysicsTransform& xf1, const RectShape& s2, const PhysicsTransform& xf2) {
+        x1[i] = xf1.position.x; y1[i] = xf1.position.y; r1[i] = s1.radius;
+        x2[i] = xf2.position.x; y2[i] = xf2.position.y;
+        cos2[i] = xf2.rotation.Cos(); sin2[i] = xf2.rotation.Sin(); hx2[i] = s2.hx; hy2[i] = s2.hy;
+    }
+
+    // the lanes have to come out bit for bit the same as the scalar versions, so pairs collide
+    // the same no matter where they land in the batch. every step below mirrors one in Collision2D.cpp
+    static __m128 Select(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    void CircleBatch::CollideCircles(u32 begin, u32 end) {
+        const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1), miss = _mm_set1_ps(-1);
+        u32 i = begin;
+        for (; i + LANES <= end; i += LANES) {
+            const __m128 dx = _mm_sub_ps(_mm_loadu_ps(&x2[i]), _mm_loadu_ps(&x1[i])),
+                         dy = _mm_sub_ps(_mm_loadu_ps(&y2[i]), _mm_loadu_ps(&y1[i])),
+                         distsq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                         r = _mm_add_ps(_mm_loadu_ps(&r1[i]), _mm_loadu_ps(&r2[i])),
+                         hit = _mm_cmplt_ps(distsq, _mm_mul_ps(r, r)),
+                         dist = _mm_sqrt_ps(distsq),
+                         apart = _mm_cmpgt_ps(dist, zero),
+                         inv = _mm_div_ps(one, dist);
+
+            _mm_storeu_ps(&nx[i],    Select(apart, _mm_mul_ps(dx, inv), zero));
+            _mm_storeu_ps(&ny[i],    Select(apart, _mm_mul_ps(dy, inv), one));
+            _mm_storeu_ps(&depth[i], Select(hit, _mm_sub_ps(r, dist), miss));
+        }
+        for (; i < end; ++i) {
+            const Manifold m = Physics2D::CollideCircles(CircleShape { r1[i] }, PhysicsTransform { { x1[i], y1[i] } },
+                                                         CircleShape { r2[i] }, PhysicsTransform { { x2[i], y2[i] } });
+            nx[i] = m.seperatingNormal.x;
+            ny[i] = m.seperatingNormal.y;
+            depth[i] = m.contactCount ? m.contactDepth[0] : -1;
+        }
+    }
+
+    void CircleBatch::CollideRects(u32 begin, u32 end) {
+        const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1), miss = _mm_set1_ps(-1),
+                     sign = _mm_set1_ps(-0.0f), infinity = _mm_set1_ps(f32s::INFINITY);
+        u32 i = begin;
+        for (; i + LANES <= end; i += LANES) {
+            const __m128 re = _mm_loadu_ps(&cos2[i]), im = _mm_loadu_ps(&sin2[i]),
+                         hx = _mm_loadu_ps(&hx2[i]), hy = _mm_loadu_ps(&hy2[i]), r = _mm_loadu_ps(&r1[i]),
+                         vx = _mm_sub_ps(_mm_loadu_ps(&x1[i]), _mm_loadu_ps(&x2[i])),
+                         vy = _mm_sub_ps(_mm_loadu_ps(&y1[i]), _mm_loadu_ps(&y2[i])),
+                         // the circle's center in the rect's frame
+                         cx = _mm_add_ps(_mm_mul_ps(vx, re), _mm_mul_ps(vy, im)),
+                         cy = _mm_sub_ps(_mm_mul_ps(vy, re), _mm_mul_ps(vx, im)),
+                         tx = _mm_sub_ps(cx, Select(_mm_cmpgt_ps(cx, zero), hx, _mm_xor_ps(hx, sign))),
+                         ty = _mm_sub_ps(cy, Select(_mm_cmpgt_ps(cy, zero), hy, _mm_xor_ps(hy, sign))),
+                         invLen = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)))),
+                         ax = _mm_mul_ps(tx, invLen), ay = _mm_mul_ps(ty, invLen);
+
+            const __m128 axesX[3] = { ax, one, zero }, axesY[3] = { ay, zero, one },
+                         projs[3] = { _mm_add_ps(_mm_mul_ps(cx, ax), _mm_mul_ps(cy, ay)), cx, cy },
+                         exts[3]  = { _mm_add_ps(_mm_andnot_ps(sign, _mm_mul_ps(hx, ax)),
+                                                 _mm_andnot_ps(sign, _mm_mul_ps(hy, ay))), hx, hy };
+
+            __m128 best = infinity, lx = zero, ly = zero, seperated = zero;
+            for (u32 k = 0; k < 3; ++k) {
+                const __m128 d1 = _mm_add_ps(_mm_add_ps(projs[k], r), exts[k]),
+                             d2 = _mm_sub_ps(_mm_add_ps(exts[k], r), projs[k]),
+                             d = _mm_min_ps(d2, d1), // std::min(d1, d2), including which one a nan gives
+                             better = _mm_cmplt_ps(d, best),
+                             flip = _mm_and_ps(_mm_cmpgt_ps(d1, d2), sign);
+                seperated = _mm_or_ps(seperated, _mm_cmple_ps(d, zero));
+                best = Select(better, d, best);
+                lx = Select(better, _mm_xor_ps(axesX[k], flip), lx);
+                ly = Select(better, _mm_xor_ps(axesY[k], flip), ly);
+            }
+
+            _mm_storeu_ps(&nx[i],    _mm_sub_ps(_mm_mul_ps(lx, re), _mm_mul_ps(ly, im)));
+            _mm_storeu_ps(&ny[i],    _mm_add_ps(_mm_mul_ps(lx, im), _mm_mul_ps(ly, re)));
+            _mm_storeu_ps(&depth[i], Select(seperated, miss, best));
+        }
+        for (; i < end; ++i) {
+            const Manifold m = CollideCircleRect(CircleShape { r1[i] }, PhysicsTransform { { x1[i], y1[i] } },
+                RectShape { hx2[i], hy2[i] },
+                PhysicsTransform { { x2[i], y2[i] }, Rotor2D::FromUnitVector({ cos2[i], sin2[i] }) });
+            nx[i] = m.seperatingNormal.x;
+            ny[i] = m.seperatingNormal.y;
+            depth[i] = m.contactCount ? m.contactDepth[0] : -1;
+        }
+    }
+
+    Manifold CircleBatch::ManifoldAt(u32 i) const {
+        if (depth[i] < 0) return Manifold::None();
+        const fv2 n = { nx[i], ny[i] };
+        return Manifold {
+            .seperatingNormal = n,
+            .contactPoint = { fv2 { x1[i], y1[i] } + n * r1[i] },
+            .contactDepth = { depth[i] },
+            .contactCount = 1,
+        };
+    }
+} // Physics2D
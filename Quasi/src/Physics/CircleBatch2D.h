@@ -0,0 +1,35 @@
+#pragma once
+#include "Manifold2D.h"
+#include "PhysicsTransform2D.h"
+#include "Utils/Vec.h"
+
+namespace Quasi::Physics2D {
+    class CircleShape;
+    class RectShape;
+
+    // circle pairs kept one array per field, so the narrowphase can collide LANES of them at once.
+    // results come out the same way, a negative depth meaning the pair doesnt touch
+    struct CircleBatch {
+        static constexpr u32 LANES = 4;
+
+        // the circle, which is always the base of the manifold
+        Vec<float> x1, y1, r1;
+        // the target. rects also need their rotation and half size, circles leave those at 0
+        Vec<float> x2, y2, r2, cos2, sin2, hx2, hy2;
+        Vec<float> nx, ny, depth;
+
+        u32 Length() const { return x1.Length(); }
+        // makes room for count pairs, which have to be filled in with SetCircle / SetRect before colliding.
+        // filling by index lets each thread gather its own range
+        void Resize(u32 count);
+        void SetCircle(u32 i, const CircleShape& s1, const fv2& p1, const CircleShape& s2, const fv2& p2);
+        void SetRect  (u32 i, const CircleShape& s1, const PhysicsTransform& xf1, const RectShape&   s2, const PhysicsTransform& xf2);
+
+        // collide pairs [begin, end) that were set with SetCircle / SetRect, a batch should only hold one kind.
+        // whatever doesnt fill a whole set of lanes at the end goes through the scalar versions
+        void CollideCircles(u32 begin, u32 end);
+        void CollideRects  (u32 begin, u32 end);
+
+        Manifold ManifoldAt(u32 i) const;
+    };
+} // Physics2D
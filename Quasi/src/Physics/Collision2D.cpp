@@ -4,6 +4,7 @@
 
 #include "Body2D.h"
 #include "SeperatingAxisSolver.h"
+#include "TimeOfImpact2D.h"
 #include "Utils/Debug/Logger.h"
 #include "Utils/Math/Geometry.h"
 
@@ -97,22 +98,57 @@ namespace Quasi::Physics2D {
         }
     }
 
+    // CircleBatch mirrors this and CollideCircleRect lane by lane, keep them in step
     Manifold CollideCircles(const CircleShape& s1, const PhysicsTransform& xf1, const CircleShape& s2, const PhysicsTransform& xf2) {
-        float distsq = xf1.position.DistSq(xf2.position);
-        if (distsq >= (s1.radius + s2.radius) * (s1.radius + s2.radius))
+        const fv2 d = xf2.position - xf1.position;
+        const float distsq = d.LenSq(), r = s1.radius + s2.radius;
+        if (distsq >= r * r)
             return Manifold::None();
 
-        distsq = std::sqrt(distsq);
-        const fv2 n = (xf2.position - xf1.position) / distsq;
+        const float dist = std::sqrt(distsq);
+        // circles on top of each other have no direction between them, any one works
+        const fv2 n = dist > 0 ? d / dist : fv2 { 0, 1 };
         return Manifold {
             .seperatingNormal = n,
-            .contactPoint = { xf1.position - n * s2.radius },
-            .contactDepth = { s1.radius + s2.radius - distsq },
+            .contactPoint = { xf1.position + n * s1.radius },
+            .contactDepth = { r - dist },
+            .contactCount = 1,
+        };
+    }
+
+    Manifold CollideCircleRect(const CircleShape& s1, const PhysicsTransform& xf1, const RectShape& s2, const PhysicsTransform& xf2) {
+        // the same axes as CollideCircleShape, towards the nearest corner then the rect's own two,
+        // only checked in the rect's frame where its own axes cost nothing
+        const fv2 c = xf2.TransformInverse(xf1.position), toCorner = (c - s2.NearestPointTo(c)).Norm();
+        const fv2 axes[3] = { toCorner, { 1, 0 }, { 0, 1 } };
+        const float projs[3] = { c.Dot(toCorner), c.x, c.y },
+                    exts[3]  = { std::abs(s2.hx * toCorner.x) + std::abs(s2.hy * toCorner.y), s2.hx, s2.hy };
+
+        float depth = f32s::INFINITY;
+        fv2 n;
+        for (u32 i = 0; i < 3; ++i) {
+            const float d1 = projs[i] + s1.radius + exts[i], d2 = exts[i] + s1.radius - projs[i],
+                        d = std::min(d1, d2);
+            if (d <= 0) return Manifold::None();
+            if (d < depth) {
+                depth = d;
+                n = d1 > d2 ? -axes[i] : axes[i];
+            }
+        }
+
+        n = xf2.TransformDir(n);
+        return Manifold {
+            .seperatingNormal = n,
+            .contactPoint = { xf1.position + n * s1.radius },
+            .contactDepth = { depth },
             .contactCount = 1,
         };
     }
 
     Manifold CollideCircleShape(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2) {
+        if (s2.TypeIndex() == IShape::RECT)
+            return CollideCircleRect(s1.AsUnsafe<CircleShape>(), xf1, s2.AsUnsafe<RectShape>(), xf2);
+
         SeperatingAxisSolver sat = SeperatingAxisSolver::CheckCollisionFor(s1, xf1, s2, xf2);
         const auto& circle = *s1.As<CircleShape>();
 
@@ -132,7 +168,24 @@ namespace Quasi::Physics2D {
         };
     }
 
+    // sat projects every point of both polygons onto every edge of both. once they have more
+    // than this many points between them, gjk + epa is cheaper since it climbs along the hulls instead
+    static constexpr u32 GJK_POLYGON_THRESHOLD = 16;
+
+    static bool UsesGjk(const Shape& s1, const Shape& s2) {
+        const auto pointCount = [] (const Shape& s) {
+            return s.TypeIndex() == IShape::POLY ? s.AsUnsafe<DynPolygonShape>().Size() : 4;
+        };
+        return pointCount(s1) + pointCount(s2) > GJK_POLYGON_THRESHOLD;
+    }
+
     Manifold CollidePolygons(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2) {
+        if (UsesGjk(s1, s2)) {
+            const PenetrationResult pen = ShapePenetration(s1, xf1, s2, xf2);
+            if (!pen.overlaps) return Manifold::None();
+            return Manifold::FromAxis(s1, xf1, s2, xf2, pen.normal);
+        }
+
         SeperatingAxisSolver sat = SeperatingAxisSolver::CheckCollisionFor(s1, xf1, s2, xf2);
         sat.CheckAxisFor(SeperatingAxisSolver::BASE);
         sat.CheckAxisFor(SeperatingAxisSolver::TARGET);
@@ -143,6 +196,78 @@ namespace Quasi::Physics2D {
         return Manifold::From(sat);
     }
 
+    bool CollidesAsWorldPolygons(const Shape& s1, const Shape& s2) {
+        const auto isPolygon = [] (const Shape& s) {
+            return s.TypeIndex() == IShape::POLY_SMALL || s.TypeIndex() == IShape::POLY;
+        };
+        return isPolygon(s1) && isPolygon(s2) && !UsesGjk(s1, s2);
+    }
+
+    void TransformPolygon(const Shape& s, const PhysicsTransform& xf, Vec<fv2>& points, Vec<fv2>& normals) {
+        if (s.TypeIndex() == IShape::POLY) {
+            const DynPolygonShape& poly = s.AsUnsafe<DynPolygonShape>();
+            for (u32 i = 0; i < poly.Size(); ++i) {
+                points.Push(xf.Transform(poly.PointAt(i)));
+                normals.Push(xf.TransformDir(poly.NormalAt(i)));
+            }
+            return;
+        }
+        const StaticPolygonShape& poly = s.AsUnsafe<StaticPolygonShape>();
+        for (u32 i = 0; i < poly.size; ++i) {
+            const i32 next = poly.WrapIndexUp(i);
+            points.Push(xf.Transform(poly.PointAt(i)));
+            normals.Push(xf.TransformDir((poly.PointAt(next) - poly.PointAt(i)).PerpendLeft() * poly.InvLenBtwn(next)));
+        }
+    }
+
+    static fRange ProjectWorldPolygon(const WorldPolygon& poly, const fv2& axis) {
+        fRange range = fRange::AntiDomain();
+        for (const fv2& p : poly.points) range.ExpandToFit(axis.Dot(p));
+        return range;
+    }
+
+    // the corner furthest along n, with whichever of its two edges faces n the most
+    static fLine2D BestWorldEdge(const WorldPolygon& poly, const fv2& n, Out<u32&> edgeIndex) {
+        const u32 count = poly.points.Length();
+        u32 furthest = 0;
+        float maxDepth = n.Dot(poly.points[0]);
+        for (u32 i = 1; i < count; ++i) {
+            if (const float d = n.Dot(poly.points[i]); d > maxDepth) {
+                maxDepth = d;
+                furthest = i;
+            }
+        }
+
+        const u32 next = furthest + 1 == count ? 0 : furthest + 1, prev = furthest ? furthest - 1 : count - 1;
+        const fv2& p = poly.points[furthest];
+        if (std::abs(poly.normals[prev].Dot(n)) > std::abs(poly.normals[furthest].Dot(n))) {
+            edgeIndex = prev;
+            return { p, poly.points[prev] - p };
+        }
+        edgeIndex = furthest;
+        return { p, poly.points[next] - p };
+    }
+
+    Manifold CollideWorldPolygons(const WorldPolygon& p1, const WorldPolygon& p2) {
+        // the same axes in the same order as the sat solver, so both settle on the same one
+        float depth = f32s::INFINITY;
+        fv2 axis;
+        for (const WorldPolygon* own : { &p1, &p2 }) {
+            for (const fv2& n : own->normals) {
+                const fRange r1 = ProjectWorldPolygon(p1, n), r2 = ProjectWorldPolygon(p2, n);
+                const float d1 = r1.max - r2.min, d2 = r2.max - r1.min, d = std::min(d1, d2);
+                if (d <= 0) return Manifold::None();
+                if (d < depth) {
+                    depth = d;
+                    axis = d1 > d2 ? -n : n;
+                }
+            }
+        }
+        u32 e1, e2;
+        const fLine2D edge1 = BestWorldEdge(p1, axis, e1), edge2 = BestWorldEdge(p2, -axis, e2);
+        return Manifold::FromFacingEdges(edge1, edge2, axis, e1, e2);
+    }
+
     Manifold CollideCapsules(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2) {
         const CapsuleShape& cap1 = s1.As<CapsuleShape>(),
                           & cap2 = s2.As<CapsuleShape>();
@@ -249,6 +374,8 @@ namespace Quasi::Physics2D {
     }
 
     bool OverlapPolygons(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2) {
+        if (UsesGjk(s1, s2)) return CoresOverlap(s1, xf1, s2, xf2);
+
         SeperatingAxisSolver sat = SeperatingAxisSolver::CheckCollisionFor(s1, xf1, s2, xf2);
         sat.CheckAxisFor(SeperatingAxisSolver::BASE);
         sat.CheckAxisFor(SeperatingAxisSolver::TARGET);
@@ -278,6 +405,102 @@ namespace Quasi::Physics2D {
         return sat.Collides();
     }
 
+    static Option<RayHit> RayCastCircle(const fv2& center, float radius, const fv2& from, const fv2& dir) {
+        const fv2 rel = from - center;
+        const float c = rel.LenSq() - radius * radius;
+        if (c < 0) return nullptr;
+
+        const float a = dir.LenSq(), b = rel.Dot(dir);
+        const float disc = b * b - a * c;
+        if (a <= 0 || disc < 0) return nullptr;
+
+        const float t = (-b - std::sqrt(disc)) / a;
+        if (t < 0 || t > 1) return nullptr;
+        const fv2 point = from + dir * t;
+        return RayHit { point, (point - center) / radius, t };
+    }
+
+    // cyrus-beck clipping against each edge, works for either winding
+    static Option<RayHit> RayCastPolygon(u32 count, Fn<const fv2&, u32> auto&& pointAt, const fv2& from, const fv2& dir) {
+        fv2 center = 0;
+        for (u32 i = 0; i < count; ++i) center += pointAt(i);
+        center /= (float)count;
+
+        float lower = 0, upper = 1;
+        fv2 normal;
+        bool entered = false;
+        for (u32 i = 0; i < count; ++i) {
+            const fv2& p = pointAt(i), &q = pointAt(i + 1 == count ? 0 : i + 1);
+            fv2 n = (q - p).PerpendRight();
+            if (n.Dot(center - p) > 0) n = -n;
+
+            const float num = n.Dot(p - from), den = n.Dot(dir);
+            if (den == 0) {
+                if (num < 0) return nullptr;
+                continue;
+            }
+            const float t = num / den;
+            if (den < 0) {
+                if (t > lower) { lower = t; normal = n; entered = true; }
+            } else if (t < upper) upper = t;
+            if (upper < lower) return nullptr;
+        }
+        // never crossing into the polygon means it started inside
+        if (!entered) return nullptr;
+        return RayHit { from + dir * lower, normal.Norm(), lower };
+    }
+
+    static Option<RayHit> RayCastCapsule(const CapsuleShape& cap, const fv2& from, const fv2& dir) {
+        const fv2 a = -cap.forward, b = cap.forward;
+        const float along = std::clamp((from - a).Dot(b - a) * cap.invLenSq * 0.25f, 0.0f, 1.0f);
+        if (from.DistSq(a + (b - a) * along) < cap.radius * cap.radius) return nullptr;
+
+        const fv2 side = cap.forward.Perpend() * (cap.radius * cap.invLength);
+        const fv2 body[4] = { a - side, b - side, b + side, a + side };
+        Option<RayHit> best = RayCastPolygon(4, [&] (u32 i) -> const fv2& { return body[i]; }, from, dir);
+        for (const fv2& end : { a, b }) {
+            const Option<RayHit> hit = RayCastCircle(end, cap.radius, from, dir);
+            if (hit && (!best || hit->fraction < best->fraction)) best = hit;
+        }
+        return best;
+    }
+
+    Option<RayHit> RayCastShape(const Shape& s, const PhysicsTransform& xf, const fv2& from, const fv2& to) {
+        const fv2 localFrom = xf.TransformInverse(from), localDir = xf.TransformInverseDir(to - from);
+        Option<RayHit> hit = nullptr;
+        switch (s.TypeIndex()) {
+            case IShape::CIRCLE:
+                hit = RayCastCircle(0, s.AsUnsafe<CircleShape>().radius, localFrom, localDir);
+                break;
+            case IShape::CAPSULE:
+                hit = RayCastCapsule(s.AsUnsafe<CapsuleShape>(), localFrom, localDir);
+                break;
+            case IShape::RECT: {
+                const RectShape& rect = s.AsUnsafe<RectShape>();
+                const fv2 corners[4] = { rect.Corner(false, false), rect.Corner(true, false),
+                                         rect.Corner(true,  true),  rect.Corner(false, true) };
+                hit = RayCastPolygon(4, [&] (u32 i) -> const fv2& { return corners[i]; }, localFrom, localDir);
+                break;
+            }
+            case IShape::POLY_SMALL: {
+                const StaticPolygonShape& poly = s.AsUnsafe<StaticPolygonShape>();
+                hit = RayCastPolygon(poly.size, [&] (u32 i) -> const fv2& { return poly.PointAt(i); }, localFrom, localDir);
+                break;
+            }
+            case IShape::POLY: {
+                const DynPolygonShape& poly = s.AsUnsafe<DynPolygonShape>();
+                hit = RayCastPolygon(poly.Size(), [&] (u32 i) -> const fv2& { return poly.PointAt(i); }, localFrom, localDir);
+                break;
+            }
+            default:;
+        }
+        if (hit) {
+            hit->point  = xf.Transform(hit->point);
+            hit->normal = xf.TransformDir(hit->normal);
+        }
+        return hit;
+    }
+
     void StaticResolve(Body& body, Body& target, const Manifold& manifold) {
         // if (manifold.flipped)
         //     std::swap(body, target);
@@ -290,18 +513,18 @@ namespace Quasi::Physics2D {
             case 1: {
                 sep *= shareForce ? 0.5f * manifold.contactDepth[0] : manifold.contactDepth[0];
                 if (bodyDyn)
-                    body.position -= sep;
+                    body.Position() -= sep;
                 if (targetDyn)
-                    target.position += sep;
+                    target.Position() += sep;
                 break;
             }
             case 2: {
                 const float depth = std::max(manifold.contactDepth[0], manifold.contactDepth[1]);
                 sep *= shareForce ? 0.5f * depth : depth;
                 if (bodyDyn)
-                    body.position -= sep;
+                    body.Position() -= sep;
                 if (targetDyn)
-                    target.position += sep;
+                    target.Position() += sep;
             }
             default: return;
         }
@@ -348,20 +571,20 @@ namespace Quasi::Physics2D {
         for (u32 i = 0; i < ContactCount; ++i) {
             const fv2& contact = manifold.contactPoint[i];
 
-            relBody  [i] = contact - body.position,
-            relTarget[i] = contact - target.position;
+            relBody  [i] = contact - body.Position(),
+            relTarget[i] = contact - target.Position();
 
             const fv2 relVel = [&] {
                 if constexpr (BDyn && TDyn) {
-                    const fv2 angularVelBody   = relBody  [i].PerpendLeft() * body.angularVelocity,
-                              angularVelTarget = relTarget[i].PerpendLeft() * target.angularVelocity;
+                    const fv2 angularVelBody   = relBody  [i].PerpendLeft() * body.AngularVelocity(),
+                              angularVelTarget = relTarget[i].PerpendLeft() * target.AngularVelocity();
 
-                    return (target.velocity + angularVelTarget) -
-                           (body  .velocity + angularVelBody);
+                    return (target.Velocity() + angularVelTarget) -
+                           (body  .Velocity() + angularVelBody);
                 } else if constexpr (BDyn) {
-                    return -body.velocity - relBody[i].Perpend() * body.angularVelocity;
+                    return -body.Velocity() - relBody[i].Perpend() * body.AngularVelocity();
                 } else /* targetDyn */ {
-                    return target.velocity + relTarget[i].Perpend() * target.angularVelocity;
+                    return target.Velocity() + relTarget[i].Perpend() * target.AngularVelocity();
                 }
             } ();
 
@@ -376,15 +599,15 @@ namespace Quasi::Physics2D {
                     const float torqueRadiusNBody   = relBody  [i].Cross(normal),
                                 torqueRadiusNTarget = relTarget[i].Cross(normal);
 
-                    return body.invMass + target.invMass +
-                          (torqueRadiusNBody   * torqueRadiusNBody)   * body  .invInertia +
-                          (torqueRadiusNTarget * torqueRadiusNTarget) * target.invInertia;
+                    return body.InvMass() + target.InvMass() +
+                          (torqueRadiusNBody   * torqueRadiusNBody)   * body  .InvInertia() +
+                          (torqueRadiusNTarget * torqueRadiusNTarget) * target.InvInertia();
                 } else if constexpr (BDyn) {
                     const float torqueRadius = relBody[i].Cross(normal);
-                    return body.invMass + torqueRadius * torqueRadius * body.invInertia;
+                    return body.InvMass() + torqueRadius * torqueRadius * body.InvInertia();
                 } else /* targetDyn */ {
                     const float torqueRadius = relTarget[i].Cross(normal);
-                    return target.invMass + torqueRadius * torqueRadius * target.invInertia;
+                    return target.InvMass() + torqueRadius * torqueRadius * target.InvInertia();
                 }
             } ();
 
@@ -412,15 +635,15 @@ namespace Quasi::Physics2D {
         for (u32 i = 0; i < ContactCount; ++i) {
             const fv2 relVel = [&] {
                 if constexpr (BDyn && TDyn) {
-                    const fv2 angularVelBody   = relBody  [i].PerpendLeft() * body.angularVelocity,
-                              angularVelTarget = relTarget[i].PerpendLeft() * target.angularVelocity;
+                    const fv2 angularVelBody   = relBody  [i].PerpendLeft() * body.AngularVelocity(),
+                              angularVelTarget = relTarget[i].PerpendLeft() * target.AngularVelocity();
 
-                    return (target.velocity + angularVelTarget) -
-                           (body  .velocity + angularVelBody);
+                    return (target.Velocity() + angularVelTarget) -
+                           (body  .Velocity() + angularVelBody);
                 } else if constexpr (BDyn) {
-                    return -body.velocity - relBody[i].Perpend() * body.angularVelocity;
+                    return -body.Velocity() - relBody[i].Perpend() * body.AngularVelocity();
                 } else /* targetDyn */ {
-                    return target.velocity + relTarget[i].Perpend() * target.angularVelocity;
+                    return target.Velocity() + relTarget[i].Perpend() * target.AngularVelocity();
                 }
             } ();
 
@@ -433,15 +656,15 @@ namespace Quasi::Physics2D {
                     const float torqueRadiusTBody   = relBody  [i].Cross(tangent),
                                 torqueRadiusTTarget = relTarget[i].Cross(tangent);
 
-                    return body.invMass + target.invMass +
-                          (torqueRadiusTBody   * torqueRadiusTBody)   * body  .invInertia +
-                          (torqueRadiusTTarget * torqueRadiusTTarget) * target.invInertia;
+                    return body.InvMass() + target.InvMass() +
+                          (torqueRadiusTBody   * torqueRadiusTBody)   * body  .InvInertia() +
+                          (torqueRadiusTTarget * torqueRadiusTTarget) * target.InvInertia();
                 } else if constexpr (BDyn) {
                     const float torqueRadius = relBody[i].Cross(tangent);
-                    return body.invMass + torqueRadius * torqueRadius * body.invInertia;
+                    return body.InvMass() + torqueRadius * torqueRadius * body.InvInertia();
                 } else /* targetDyn */ {
                     const float torqueRadius = relTarget[i].Cross(tangent);
-                    return target.invMass + torqueRadius * torqueRadius * target.invInertia;
+                    return target.InvMass() + torqueRadius * torqueRadius * target.InvInertia();
                 }
             } ();
 
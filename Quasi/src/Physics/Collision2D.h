@@ -1,11 +1,15 @@
 #pragma once
 #include "Manifold2D.h"
+#include "Utils/Option.h"
+#include "Utils/Span.h"
+#include "Utils/Vec.h"
 #include "Utils/Math/Vector.h"
 
 namespace Quasi::Physics2D {
     class Shape;
     class CircleShape;
     class CapsuleShape;
+    class RectShape;
     class Body;
 }
 
@@ -17,10 +21,24 @@ namespace Quasi::Physics2D {
 
     Manifold CollideCircles       (const CircleShape& s1, const PhysicsTransform& xf1, const CircleShape& s2, const PhysicsTransform& xf2);
     Manifold CollideCircleShape   (const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2);
+    Manifold CollideCircleRect    (const CircleShape& s1, const PhysicsTransform& xf1, const RectShape& s2,   const PhysicsTransform& xf2);
     Manifold CollidePolygons      (const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2);
     Manifold CollideCapsules      (const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2);
     Manifold CollidePolygonCapsule(const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2);
 
+    // a polygon's corners and edge normals already moved into world space, edge i runs from point i to i + 1.
+    // normals have unit length, but face in or out depending on the winding
+    struct WorldPolygon {
+        Span<const fv2> points, normals;
+    };
+
+    // polygon pairs that collide through sat, where moving each polygon into world space once pays off
+    bool CollidesAsWorldPolygons(const Shape& s1, const Shape& s2);
+    // appends the corners and edge normals of a polygon shape in world space
+    void TransformPolygon(const Shape& s, const PhysicsTransform& xf, Vec<fv2>& points, Vec<fv2>& normals);
+    // the same sat and clipping as CollidePolygons, without transforming anything per pair
+    Manifold CollideWorldPolygons(const WorldPolygon& p1, const WorldPolygon& p2);
+
     bool OverlapShapes(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2);
 
     bool OverlapCircles       (const CircleShape& s1, const PhysicsTransform& xf1, const CircleShape& s2, const PhysicsTransform& xf2);
@@ -29,6 +47,14 @@ namespace Quasi::Physics2D {
     bool OverlapCapsules      (const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2);
     bool OverlapPolygonCapsule(const Shape& s1,       const PhysicsTransform& xf1, const Shape& s2,       const PhysicsTransform& xf2);
 
+    struct RayHit {
+        fv2 point, normal;
+        float fraction = 1; // how far along the segment the hit is
+    };
+
+    // segments starting inside the shape dont hit it
+    Option<RayHit> RayCastShape(const Shape& s, const PhysicsTransform& xf, const fv2& from, const fv2& to);
+
     void StaticResolve (Body& body, Body& target, const Manifold& manifold);
     template <u32 ContactCount, bool BDyn, bool TDyn>
     void DynamicResolveFor(Body& body, Body& target, const Manifold& manifold);
@@ -0,0 +1,351 @@
+#include "ContactSolver2D.h"
+
+#include <algorithm>
+#include "Body2D.h"
+#include "Snapshot2D.h"
+
+namespace Quasi::Physics2D {
+    BodyPairKey::BodyPairKey(const Body& a, const Body& b) {
+        const usize x = reinterpret_cast<usize>(&a), y = reinterpret_cast<usize>(&b);
+        first  = std::min(x, y);
+        second = std::max(x, y);
+    }
+
+    Hashing::Hash BodyPairKey::GetHashCode() const {
+        return Hashing::HashCombine(Hashing::HashInt(first), Hashing::HashInt(second));
+    }
+
+    void ContactSolver::Clear() {
+        contacts.Clear();
+        contactLookup.Clear();
+        endedContacts.Clear();
+    }
+
+    void ContactSolver::RemoveBody(const Body& body) {
+        for (u32 i = 0; i < contacts.Length();) {
+            ContactConstraint& c = contacts[i];
+            if (c.body.RefEquals(body) || c.target.RefEquals(body)) {
+                c.body->Wake();
+                c.target->Wake();
+                RemoveAt(i);
+            } else ++i;
+        }
+    }
+
+    void ContactSolver::BeginContacts() {
+        for (ContactConstraint& c : contacts) c.touched = false;
+    }
+
+    void ContactSolver::AddManifold(Body& body, Body& target, const Manifold& manifold) {
+        const BodyPairKey key { body, target };
+        const OptRef<const u32> existing = contactLookup.Get(key);
+
+        ContactConstraint* c;
+        bool flip = false;
+        if (existing) {
+            c = &contacts[*existing];
+            // keep the order the contact was first created with
+            flip = !c->body.RefEquals(body);
+        } else {
+            contactLookup.Insert(key, (u32)contacts.Length());
+            c = &contacts.Push({ .body = body, .target = target, .pointCount = 0 });
+        }
+
+        const fv2 normal = flip ? -manifold.seperatingNormal : manifold.seperatingNormal;
+        // a contact that swapped sides cant reuse its old impulses
+        const bool canWarmStart = existing && c->normal.Dot(normal) > 0.95f;
+
+        ContactPoint oldPoints[2] = { c->points[0], c->points[1] };
+        const u32 oldCount = c->pointCount;
+
+        c->normal = normal;
+        c->pointCount = manifold.contactCount;
+        c->touched = true;
+        for (u32 i = 0; i < manifold.contactCount; ++i) {
+            ContactPoint& p = c->points[i];
+            p = {
+                .relBody   = manifold.contactPoint[i] - c->body->Position(),
+                .relTarget = manifold.contactPoint[i] - c->target->Position(),
+                .depth     = manifold.contactDepth[i],
+                .id        = manifold.contactId[i],
+            };
+            if (!canWarmStart) continue;
+            for (u32 j = 0; j < oldCount; ++j) {
+                if (oldPoints[j].id != p.id) continue;
+                p.normalImpulse  = oldPoints[j].normalImpulse;
+                p.tangentImpulse = oldPoints[j].tangentImpulse;
+                break;
+            }
+        }
+    }
+
+    void ContactSolver::KeepContact(const Body& body, const Body& target) {
+        if (const OptRef<const u32> i = contactLookup.Get(BodyPairKey { body, target }))
+            contacts[*i].touched = true;
+    }
+
+    void ContactSolver::EndContacts() {
+        for (u32 i = 0; i < contacts.Length();) {
+            if (!contacts[i].touched)
+                RemoveAt(i);
+            else ++i;
+        }
+    }
+
+    static bool IsAsleep(const ContactConstraint& c) {
+        return !c.body->IsAwake() && !c.target->IsAwake();
+    }
+
+    void ContactSolver::Solve(float dt, OptRef<ThreadPool> pool) {
+        if (dt <= 0) return;
+        const float invDt = 1 / dt;
+
+        // islands never write to each other's bodies, so going through them one by one gives
+        // exactly the same result as this, it just costs more to set up
+        if (!pool) {
+            islandStarts.Clear();
+            for (ContactConstraint& c : contacts) {
+                if (IsAsleep(c)) continue;
+                PreStep(c, invDt);
+                if (warmStarting) WarmStart(c);
+            }
+            for (u32 i = 0; i < velocityIterations; ++i) {
+                for (ContactConstraint& c : contacts) {
+                    if (IsAsleep(c)) continue;
+                    SolveVelocity(c);
+                }
+            }
+            return;
+        }
+
+        BuildIslands();
+        islandOrder.Clear();
+        for (u32 i = 0; i < IslandCount(); ++i) islandOrder.Push(i);
+        std::sort(islandOrder.Data(), islandOrder.Data() + islandOrder.Length(), [&] (u32 a, u32 b) {
+            return islandStarts[a + 1] - islandStarts[a] > islandStarts[b + 1] - islandStarts[b];
+        });
+        pool->ParallelFor(IslandCount(), islandGrain, [&] (u32 begin, u32 end) {
+            for (u32 i = begin; i < end; ++i) SolveIsland(islandOrder[i], invDt);
+        });
+    }
+
+    static u32 FindRoot(Vec<u32>& parents, u32 i) {
+        while (parents[i] != i) {
+            parents[i] = parents[parents[i]];
+            i = parents[i];
+        }
+        return i;
+    }
+
+    void ContactSolver::BuildIslands() {
+        static constexpr u32 NONE = ~0u;
+
+        u32 bodyCount = 0;
+        for (const ContactConstraint& c : contacts)
+            bodyCount = std::max({ bodyCount, c.body->Index() + 1, c.target->Index() + 1 });
+        bodyParents.Clear();
+        for (u32 i = 0; i < bodyCount; ++i) bodyParents.Push(i);
+
+        // only dynamic bodies join islands, the rest never take impulses so islands can share them
+        for (const ContactConstraint& c : contacts) {
+            if (IsAsleep(c) || !c.body->IsDynamic() || !c.target->IsDynamic()) continue;
+            const u32 a = FindRoot(bodyParents, c.body->Index()), b = FindRoot(bodyParents, c.target->Index());
+            if (a != b) bodyParents[std::max(a, b)] = std::min(a, b);
+        }
+
+        // islands are numbered in order of their first contact, then contacts are counting sorted into them
+        rootIslands.Clear();
+        rootIslands.Resize(bodyCount, NONE);
+        contactIslands.Clear();
+        islandStarts.Clear();
+        for (const ContactConstraint& c : contacts) {
+            if (IsAsleep(c)) {
+                contactIslands.Push(NONE);
+                continue;
+            }
+            const Body& anchor = c.body->IsDynamic() ? *c.body : *c.target;
+            u32& island = rootIslands[FindRoot(bodyParents, anchor.Index())];
+            if (island == NONE) {
+                island = islandStarts.Length();
+                islandStarts.Push(0);
+            }
+            ++islandStarts[island];
+            contactIslands.Push(island);
+        }
+
+        u32 offset = 0;
+        for (u32& start : islandStarts) {
+            const u32 count = start;
+            start = offset;
+            offset += count;
+        }
+        islandStarts.Push(offset);
+
+        islandContacts.Clear();
+        islandContacts.Resize(offset, 0);
+        for (u32 i = 0; i < contacts.Length(); ++i) {
+            if (contactIslands[i] == NONE) continue;
+            islandContacts[islandStarts[contactIslands[i]]++] = i;
+        }
+        // placing the contacts moved every start to the next island's, shift them back
+        for (u32 i = IslandCount(); i > 0; --i) islandStarts[i] = islandStarts[i - 1];
+        islandStarts[0] = 0;
+    }
+
+    void ContactSolver::SolveIsland(u32 island, float invDt) {
+        const u32 begin = islandStarts[island], end = islandStarts[island + 1];
+        for (u32 i = begin; i < end; ++i) {
+            ContactConstraint& c = contacts[islandContacts[i]];
+            PreStep(c, invDt);
+            if (warmStarting) WarmStart(c);
+        }
+
+        for (u32 iter = 0; iter < velocityIterations; ++iter) {
+            for (u32 i = begin; i < end; ++i)
+                SolveVelocity(contacts[islandContacts[i]]);
+        }
+    }
+
+    void ContactSolver::PreStep(ContactConstraint& c, float invDt) const {
+        const Body& body = *c.body, &target = *c.target;
+        c.invMassBody      = body.IsDynamic()   ? body.InvMass()    : 0;
+        c.invInertiaBody   = body.IsDynamic()   ? body.InvInertia() : 0;
+        c.invMassTarget    = target.IsDynamic() ? target.InvMass()    : 0;
+        c.invInertiaTarget = target.IsDynamic() ? target.InvInertia() : 0;
+
+        const fv2 normal = c.normal, tangent = normal.PerpendRight();
+        for (u32 i = 0; i < c.pointCount; ++i) {
+            ContactPoint& p = c.points[i];
+
+            const float rnBody = p.relBody.Cross(normal), rnTarget = p.relTarget.Cross(normal);
+            const float kNormal = c.invMassBody + c.invMassTarget +
+                                  rnBody   * rnBody   * c.invInertiaBody +
+                                  rnTarget * rnTarget * c.invInertiaTarget;
+            p.normalMass = kNormal > 0 ? 1 / kNormal : 0;
+
+            const float rtBody = p.relBody.Cross(tangent), rtTarget = p.relTarget.Cross(tangent);
+            const float kTangent = c.invMassBody + c.invMassTarget +
+                                   rtBody   * rtBody   * c.invInertiaBody +
+                                   rtTarget * rtTarget * c.invInertiaTarget;
+            p.tangentMass = kTangent > 0 ? 1 / kTangent : 0;
+
+            const fv2 relVel = (target.Velocity() + p.relTarget.Perpend() * target.AngularVelocity()) -
+                               (body  .Velocity() + p.relBody  .Perpend() * body  .AngularVelocity());
+            const float approach = relVel.Dot(normal);
+
+            p.velocityBias = baumgarte * invDt * std::max(p.depth - slop, 0.0f);
+            if (approach < -restitutionThreshold)
+                p.velocityBias = std::max(p.velocityBias, -restitution * approach);
+        }
+    }
+
+    void ContactSolver::WarmStart(ContactConstraint& c) const {
+        Body& body = *c.body, &target = *c.target;
+        const fv2 tangent = c.normal.PerpendRight();
+        for (u32 i = 0; i < c.pointCount; ++i) {
+            const ContactPoint& p = c.points[i];
+            const fv2 impulse = c.normal * p.normalImpulse + tangent * p.tangentImpulse;
+
+            if (c.invMassBody != 0) {
+                body.Velocity()        -= impulse * c.invMassBody;
+                body.AngularVelocity() -= p.relBody.Cross(impulse) * c.invInertiaBody;
+            }
+            if (c.invMassTarget != 0) {
+                target.Velocity()        += impulse * c.invMassTarget;
+                target.AngularVelocity() += p.relTarget.Cross(impulse) * c.invInertiaTarget;
+            }
+        }
+    }
+
+    void ContactSolver::SolveVelocity(ContactConstraint& c) const {
+        Body& body = *c.body, &target = *c.target;
+        const fv2 normal = c.normal, tangent = normal.PerpendRight();
+
+        const auto relativeVelocity = [&] (const ContactPoint& p) {
+            return (target.Velocity() + p.relTarget.Perpend() * target.AngularVelocity()) -
+                   (body  .Velocity() + p.relBody  .Perpend() * body  .AngularVelocity());
+        };
+        // bodies that dont respond are left untouched, other islands may be reading them at the same time
+        const auto applyImpulse = [&] (const ContactPoint& p, const fv2& impulse) {
+            if (c.invMassBody != 0) {
+                body.Velocity()        -= impulse * c.invMassBody;
+                body.AngularVelocity() -= p.relBody.Cross(impulse) * c.invInertiaBody;
+            }
+            if (c.invMassTarget != 0) {
+                target.Velocity()        += impulse * c.invMassTarget;
+                target.AngularVelocity() += p.relTarget.Cross(impulse) * c.invInertiaTarget;
+            }
+        };
+
+        // normal impulses, accumulated impulse can only push
+        for (u32 i = 0; i < c.pointCount; ++i) {
+            ContactPoint& p = c.points[i];
+            const float vn = relativeVelocity(p).Dot(normal);
+            const float prev = p.normalImpulse;
+            p.normalImpulse = std::max(prev + p.normalMass * (p.velocityBias - vn), 0.0f);
+            applyImpulse(p, normal * (p.normalImpulse - prev));
+        }
+
+        // friction, bounded by the normal impulse
+        for (u32 i = 0; i < c.pointCount; ++i) {
+            ContactPoint& p = c.points[i];
+            const float vt = relativeVelocity(p).Dot(tangent);
+            const float maxFriction = friction * p.normalImpulse;
+            const float prev = p.tangentImpulse;
+            p.tangentImpulse = std::clamp(prev - p.tangentMass * vt, -maxFriction, maxFriction);
+            applyImpulse(p, tangent * (p.tangentImpulse - prev));
+        }
+    }
+
+    void ContactSolver::ClearContactEvents() {
+        for (ContactConstraint& c : contacts) c.isNew = false;
+        endedContacts.Clear();
+    }
+
+    // no padding, so equal contacts save to equal bytes
+    struct SavedContact {
+        u32 body, target;
+        fv2 normal;
+        ContactPoint points[2];
+        u32 pointCount;
+        float invMassBody, invInertiaBody, invMassTarget, invInertiaTarget;
+        u32 touched, isNew;
+    };
+
+    void ContactSolver::Save(SnapshotWriter& out) const {
+        out.Write((u32)contacts.Length());
+        for (const ContactConstraint& c : contacts)
+            out.Write(SavedContact {
+                c.body->Index(), c.target->Index(), c.normal, { c.points[0], c.points[1] }, c.pointCount,
+                c.invMassBody, c.invInertiaBody, c.invMassTarget, c.invInertiaTarget, c.touched, c.isNew
+            });
+    }
+
+    void ContactSolver::Load(SnapshotReader& in, Span<Box<Body>> bodies) {
+        contacts.Clear();
+        contactLookup.Clear();
+        endedContacts.Clear();
+        const u32 count = in.Read<u32>();
+        for (u32 i = 0; i < count; ++i) {
+            const SavedContact saved = in.Read<SavedContact>();
+            Body& body = *bodies[saved.body], &target = *bodies[saved.target];
+            contacts.Push({
+                .body = body, .target = target, .normal = saved.normal,
+                .points = { saved.points[0], saved.points[1] }, .pointCount = saved.pointCount,
+                .invMassBody   = saved.invMassBody,   .invInertiaBody   = saved.invInertiaBody,
+                .invMassTarget = saved.invMassTarget, .invInertiaTarget = saved.invInertiaTarget,
+                .touched = saved.touched != 0, .isNew = saved.isNew != 0
+            });
+            contactLookup.Insert(BodyPairKey { body, target }, i);
+        }
+    }
+
+    void ContactSolver::RemoveAt(u32 i) {
+        const ContactConstraint& c = contacts[i];
+        endedContacts.Push({ c.body->Handle(), c.target->Handle(), c.isNew });
+        contactLookup.Remove(BodyPairKey { *contacts[i].body, *contacts[i].target });
+        contacts.PopUnordered(i);
+        if (i < contacts.Length())
+            contactLookup[BodyPairKey { *contacts[i].body, *contacts[i].target }] = i;
+    }
+} // Physics2D
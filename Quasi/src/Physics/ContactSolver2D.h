@@ -0,0 +1,114 @@
+#pragma once
+#include "BodyStorage2D.h"
+#include "Manifold2D.h"
+#include "Utils/Box.h"
+#include "Utils/Hash.h"
+#include "Utils/HashMap.h"
+#include "Utils/ThreadPool.h"
+#include "Utils/Vec.h"
+
+namespace Quasi::Physics2D {
+    class Body;
+    class SnapshotWriter;
+    class SnapshotReader;
+
+    struct ContactPoint {
+        fv2 relBody, relTarget; // contact point relative to each body's center
+        float depth = 0;
+        float normalMass = 0, tangentMass = 0;
+        float velocityBias = 0;
+        // accumulated impulses, kept between steps for warm starting
+        float normalImpulse = 0, tangentImpulse = 0;
+        u32 id = 0;
+    };
+
+    struct ContactConstraint {
+        Ref<Body> body, target;
+        fv2 normal; // points from body to target
+        ContactPoint points[2];
+        u32 pointCount = 0;
+        // inverse masses are zeroed for bodies that dont respond to collisions
+        float invMassBody = 0, invInertiaBody = 0, invMassTarget = 0, invInertiaTarget = 0;
+        bool touched = true;
+        bool isNew = true; // created since the last ClearContactEvents
+    };
+
+    // a contact that was dropped. the bodies are named by handle since they can be deleted by now
+    struct EndedContact {
+        BodyHandle body, target;
+        bool wasNew = false;
+    };
+
+    struct BodyPairKey {
+        usize first, second;
+
+        BodyPairKey(const Body& a, const Body& b);
+        bool operator==(const BodyPairKey&) const = default;
+        Hashing::Hash GetHashCode() const;
+    };
+
+    // sequential impulse solver over persistent contacts.
+    // accumulated impulses are matched up by body pair and feature id every step,
+    // so resting contacts start close to their solution.
+    // contacts are split into islands that share no dynamic bodies. each island is solved on its own,
+    // in contact order, so the result is the same whichever thread solves it
+    class ContactSolver {
+        Vec<ContactConstraint> contacts;
+        HashMap<BodyPairKey, u32> contactLookup;
+        Vec<EndedContact> endedContacts;
+
+        // scratch for finding islands, a union find over body indices
+        Vec<u32> bodyParents, rootIslands, contactIslands;
+        // contact indices grouped by island, islandStarts holds where each island starts and then the end
+        Vec<u32> islandContacts, islandStarts;
+        // biggest islands first, so one big pile doesnt end up started last
+        Vec<u32> islandOrder;
+    public:
+        u32 velocityIterations = 8;
+        float friction = 0.6f;
+        float restitution = 0.0f;
+        // approach speed needed before restitution applies, so resting contacts dont jitter
+        float restitutionThreshold = 2.0f;
+        // fraction of penetration to remove per step, and the penetration allowed to stay
+        float baumgarte = 0.2f, slop = 0.01f;
+        bool warmStarting = true;
+        // islands handed to each task when solving on multiple threads
+        u32 islandGrain = 1;
+
+        void Clear();
+        // removes every contact of the body, waking whatever it was touching
+        void RemoveBody(const Body& body);
+
+        // marks every contact stale, call before adding this step's manifolds
+        void BeginContacts();
+        void AddManifold(Body& body, Body& target, const Manifold& manifold);
+        // keeps a contact alive without updating it, used for sleeping pairs
+        void KeepContact(const Body& body, const Body& target);
+        // drops contacts that weren't touched this step
+        void EndContacts();
+
+        // islands are spread over the pool's threads when one is given
+        void Solve(float dt, OptRef<ThreadPool> pool = nullptr);
+
+        usize ContactCount() const { return contacts.Length(); }
+        // islands found by the last Solve, sleeping ones aren't counted.
+        // they're only split up when solving on a pool, otherwise this is 0
+        u32 IslandCount() const { return islandStarts.IsEmpty() ? 0 : islandStarts.Length() - 1; }
+        Span<const ContactConstraint> Contacts() const { return contacts.AsSpan(); }
+        // contacts dropped since the last ClearContactEvents
+        Span<const EndedContact> EndedContacts() const { return endedContacts.AsSpan(); }
+        // marks every contact as old and forgets the dropped ones
+        void ClearContactEvents();
+
+        // contacts are saved with their bodies' indices and looked up in bodies when loading
+        void Save(SnapshotWriter& out) const;
+        void Load(SnapshotReader& in, Span<Box<Body>> bodies);
+    private:
+        void BuildIslands();
+        void SolveIsland(u32 island, float invDt);
+        void PreStep(ContactConstraint& c, float invDt) const;
+        void WarmStart(ContactConstraint& c) const;
+        void SolveVelocity(ContactConstraint& c) const;
+        void RemoveAt(u32 i);
+    };
+} // Physics2D
@@ -0,0 +1,252 @@
+#include "DynamicTree2D.h"
+
+#include "Body2D.h"
+#include "Snapshot2D.h"
+
+namespace Quasi::Physics2D {
+    u32 DynamicTree::CreateProxy(const fRect2D& box, Body& body) {
+        const u32 proxy = AllocateNode();
+        Node& node = nodes[proxy];
+        node.box = box.Extrude(margin);
+        node.body = body;
+        node.height = 0;
+        node.moved = true;
+        InsertLeaf(proxy);
+        movedProxies.Push(proxy);
+        ++proxyCount;
+        return proxy;
+    }
+
+    void DynamicTree::DestroyProxy(u32 proxy) {
+        if (nodes[proxy].moved) {
+            movedProxies.Remove(proxy);
+        }
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        --proxyCount;
+    }
+
+    bool DynamicTree::MoveProxy(u32 proxy, const fRect2D& box) {
+        Node& node = nodes[proxy];
+        if (node.box.Contains(box)) return false;
+
+        RemoveLeaf(proxy);
+        nodes[proxy].box = box.Extrude(margin);
+        InsertLeaf(proxy);
+
+        if (!nodes[proxy].moved) {
+            nodes[proxy].moved = true;
+            movedProxies.Push(proxy);
+        }
+        return true;
+    }
+
+    void DynamicTree::Clear() {
+        nodes.Clear();
+        movedProxies.Clear();
+        root = NULL_NODE;
+        freeList = NULL_NODE;
+        proxyCount = 0;
+    }
+
+    void DynamicTree::ClearMoved() {
+        for (const u32 proxy : movedProxies) {
+            nodes[proxy].moved = false;
+        }
+        movedProxies.Clear();
+    }
+
+    // no padding, so equal trees save to equal bytes
+    struct SavedTreeNode {
+        fRect2D box;
+        u32 body, parent, child1, child2;
+        i32 height;
+        u32 moved;
+    };
+
+    void DynamicTree::Save(SnapshotWriter& out) const {
+        out.Write(root);
+        out.Write(freeList);
+        out.Write(proxyCount);
+        out.WriteSpan(movedProxies.AsSpan());
+        out.Write((u32)nodes.Length());
+        for (const Node& n : nodes)
+            out.Write(SavedTreeNode { n.box, n.body ? n.body->Index() : NULL_NODE, n.parent, n.child1, n.child2, n.height, n.moved });
+    }
+
+    void DynamicTree::Load(SnapshotReader& in, Span<Box<Body>> bodies) {
+        root       = in.Read<u32>();
+        freeList   = in.Read<u32>();
+        proxyCount = in.Read<u32>();
+        in.ReadVec(movedProxies);
+        nodes.Resize(in.Read<u32>());
+        for (Node& n : nodes) {
+            const SavedTreeNode saved = in.Read<SavedTreeNode>();
+            n.box    = saved.box;
+            n.body   = saved.body == NULL_NODE ? nullptr : OptRef<Body> { *bodies[saved.body] };
+            n.parent = saved.parent;
+            n.child1 = saved.child1;
+            n.child2 = saved.child2;
+            n.height = saved.height;
+            n.moved  = saved.moved != 0;
+        }
+    }
+
+    u32 DynamicTree::AllocateNode() {
+        if (freeList == NULL_NODE) {
+            nodes.Push({});
+            return nodes.Length() - 1;
+        }
+        const u32 id = freeList;
+        freeList = nodes[id].parent;
+        nodes[id] = {};
+        return id;
+    }
+
+    void DynamicTree::FreeNode(u32 id) {
+        nodes[id].parent = freeList;
+        nodes[id].body   = nullptr;
+        nodes[id].height = -1;
+        nodes[id].moved  = false;
+        freeList = id;
+    }
+
+    void DynamicTree::InsertLeaf(u32 leaf) {
+        if (root == NULL_NODE) {
+            root = leaf;
+            nodes[root].parent = NULL_NODE;
+            return;
+        }
+
+        // find the best sibling by the surface area heuristic
+        const fRect2D leafBox = nodes[leaf].box;
+        u32 index = root;
+        while (!nodes[index].IsLeaf()) {
+            const Node& node = nodes[index];
+            const float area = Perimeter(node.box);
+            const float combinedArea = Perimeter(node.box.Union(leafBox));
+
+            // cost of creating a new parent for this node and the new leaf
+            const float cost = 2 * combinedArea;
+            // minimum cost of pushing the leaf further down the tree
+            const float inheritanceCost = 2 * (combinedArea - area);
+
+            const auto descendCost = [&] (u32 child) {
+                const Node& c = nodes[child];
+                const float grown = Perimeter(c.box.Union(leafBox));
+                return c.IsLeaf() ? grown + inheritanceCost : grown - Perimeter(c.box) + inheritanceCost;
+            };
+            const float cost1 = descendCost(node.child1), cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2) break;
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        const u32 sibling = index;
+        const u32 oldParent = nodes[sibling].parent;
+        const u32 newParent = AllocateNode();
+        Node& parent = nodes[newParent];
+        parent.parent = oldParent;
+        parent.box = leafBox.Union(nodes[sibling].box);
+        parent.height = nodes[sibling].height + 1;
+        parent.child1 = sibling;
+        parent.child2 = leaf;
+
+        if (oldParent != NULL_NODE) {
+            if (nodes[oldParent].child1 == sibling) nodes[oldParent].child1 = newParent;
+            else                                    nodes[oldParent].child2 = newParent;
+        } else {
+            root = newParent;
+        }
+        nodes[sibling].parent = newParent;
+        nodes[leaf].parent = newParent;
+
+        RecalculateUpwards(nodes[leaf].parent);
+    }
+
+    void DynamicTree::RemoveLeaf(u32 leaf) {
+        if (leaf == root) {
+            root = NULL_NODE;
+            return;
+        }
+
+        const u32 parent = nodes[leaf].parent;
+        const u32 grandParent = nodes[parent].parent;
+        const u32 sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+        if (grandParent != NULL_NODE) {
+            // destroy parent and connect sibling to grandParent
+            if (nodes[grandParent].child1 == parent) nodes[grandParent].child1 = sibling;
+            else                                     nodes[grandParent].child2 = sibling;
+            nodes[sibling].parent = grandParent;
+            FreeNode(parent);
+            RecalculateUpwards(grandParent);
+        } else {
+            root = sibling;
+            nodes[sibling].parent = NULL_NODE;
+            FreeNode(parent);
+        }
+    }
+
+    void DynamicTree::RecalculateUpwards(u32 id) {
+        while (id != NULL_NODE) {
+            id = Balance(id);
+
+            Node& node = nodes[id];
+            const Node& c1 = nodes[node.child1], &c2 = nodes[node.child2];
+            node.height = 1 + std::max(c1.height, c2.height);
+            node.box = c1.box.Union(c2.box);
+
+            id = node.parent;
+        }
+    }
+
+    // performs a left or right rotation if node A is imbalanced, returning the new subtree root
+    u32 DynamicTree::Balance(u32 iA) {
+        Node& a = nodes[iA];
+        if (a.IsLeaf() || a.height < 2) return iA;
+
+        const u32 iB = a.child1, iC = a.child2;
+        Node& b = nodes[iB];
+        Node& c = nodes[iC];
+        const i32 balance = c.height - b.height;
+
+        const auto rotate = [&] (u32 iUp, u32 iOther, bool upIsChild2) {
+            // iUp gets promoted to replace A
+            Node& up = nodes[iUp];
+            const u32 iF = up.child1, iG = up.child2;
+            Node& f = nodes[iF];
+            Node& g = nodes[iG];
+
+            up.child1 = iA;
+            up.parent = a.parent;
+            a.parent = iUp;
+
+            if (up.parent != NULL_NODE) {
+                if (nodes[up.parent].child1 == iA) nodes[up.parent].child1 = iUp;
+                else                               nodes[up.parent].child2 = iUp;
+            } else {
+                root = iUp;
+            }
+
+            const Node& other = nodes[iOther];
+            // keep the taller grandchild attached to the promoted node
+            const bool keepF = f.height > g.height;
+            const u32 iKeep = keepF ? iF : iG, iMove = keepF ? iG : iF;
+            Node& move = nodes[iMove];
+
+            up.child2 = iKeep;
+            (upIsChild2 ? a.child2 : a.child1) = iMove;
+            move.parent = iA;
+            a.box = other.box.Union(move.box);
+            a.height = 1 + std::max(other.height, move.height);
+            up.box = a.box.Union(nodes[iKeep].box);
+            up.height = 1 + std::max(a.height, nodes[iKeep].height);
+            return iUp;
+        };
+
+        if (balance > 1)  return rotate(iC, iB, true);  // rotate C up
+        if (balance < -1) return rotate(iB, iC, false); // rotate B up
+        return iA;
+    }
+} // Quasi
@@ -0,0 +1,133 @@
+#pragma once
+#include <cmath>
+#include "PhysicsTransform2D.h"
+#include "Utils/Box.h"
+#include "Utils/Math/Rect.h"
+#include "Utils/Vec.h"
+
+namespace Quasi::Physics2D {
+    class Body;
+    class SnapshotWriter;
+    class SnapshotReader;
+
+    // bounding volume hierarchy of fattened boxes, used as a broadphase.
+    // leaves only get reinserted once their tight box escapes the fat box,
+    // so resting and slow bodies cost almost nothing to keep updated.
+    class DynamicTree {
+    public:
+        static constexpr u32 NULL_NODE = ~0u;
+        static constexpr u32 QUERY_STACK_SIZE = 256;
+
+        struct Node {
+            fRect2D box;
+            OptRef<Body> body = nullptr; // only set on leaves
+            u32 parent = NULL_NODE;      // next free node when unused
+            u32 child1 = NULL_NODE, child2 = NULL_NODE;
+            i32 height = -1;             // leaves are 0, free nodes are -1
+            bool moved = false;
+
+            bool IsLeaf() const { return child1 == NULL_NODE; }
+        };
+    private:
+        Vec<Node> nodes;
+        u32 root = NULL_NODE, freeList = NULL_NODE;
+        u32 proxyCount = 0;
+        Vec<u32> movedProxies;
+    public:
+        float margin = 0.5f;
+
+        DynamicTree() = default;
+        DynamicTree(float margin) : margin(margin) {}
+
+        u32 CreateProxy(const fRect2D& box, Body& body);
+        void DestroyProxy(u32 proxy);
+        // returns true if the proxy had to be reinserted
+        bool MoveProxy(u32 proxy, const fRect2D& box);
+        void Clear();
+
+        const fRect2D& FatBoxOf(u32 proxy) const { return nodes[proxy].box; }
+        Body& BodyOf(u32 proxy) { return *nodes[proxy].body; }
+        const Body& BodyOf(u32 proxy) const { return *nodes[proxy].body; }
+        bool WasMoved(u32 proxy) const { return nodes[proxy].moved; }
+
+        Span<const u32> MovedProxies() const { return movedProxies.AsSpan(); }
+        void ClearMoved();
+
+        // leaves are saved with their body's index and looked up in bodies when loading
+        void Save(SnapshotWriter& out) const;
+        void Load(SnapshotReader& in, Span<Box<Body>> bodies);
+
+        u32 ProxyCount() const { return proxyCount; }
+        i32 Height() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+
+        // calls the callback with every proxy whose fat box overlaps the box,
+        // stopping early if it returns false
+        void Query(const fRect2D& box, Fn<bool, u32> auto&& callback) const {
+            if (root == NULL_NODE) return;
+
+            u32 stack[QUERY_STACK_SIZE];
+            u32 top = 0;
+            stack[top++] = root;
+            while (top) {
+                const u32 id = stack[--top];
+                const Node& node = nodes[id];
+                if (!node.box.Overlaps(box)) continue;
+
+                if (node.IsLeaf()) {
+                    if (!callback(id)) return;
+                } else {
+                    stack[top++] = node.child1;
+                    stack[top++] = node.child2;
+                }
+            }
+        }
+
+        // calls the callback with every proxy whose fat box the segment from -> to crosses.
+        // the callback gets the current max fraction along the segment and returns the new one,
+        // so closest hit searches can shrink the segment as they go. returning 0 stops the cast.
+        void RayCast(const fv2& from, const fv2& to, Fn<float, u32, float> auto&& callback, float maxFraction = 1) const {
+            if (root == NULL_NODE) return;
+
+            const fv2 dir = to - from;
+            // boxes further than this from the infinite line cant be crossed
+            const fv2 perp = dir.Perpend(), absPerp = { std::abs(perp.x), std::abs(perp.y) };
+            const fv2 reach = from + dir * maxFraction;
+            fRect2D segmentBox = fRect2D { fv2::Min(from, reach), fv2::Max(from, reach) };
+
+            u32 stack[QUERY_STACK_SIZE];
+            u32 top = 0;
+            stack[top++] = root;
+            while (top) {
+                const u32 id = stack[--top];
+                const Node& node = nodes[id];
+                if (!node.box.Overlaps(segmentBox)) continue;
+
+                const fv2 center = node.box.Center(), extent = node.box.Size() * 0.5f;
+                if (std::abs(perp.Dot(from - center)) > absPerp.Dot(extent)) continue;
+
+                if (node.IsLeaf()) {
+                    const float fraction = callback(id, maxFraction);
+                    if (fraction <= 0) return;
+                    if (fraction < maxFraction) {
+                        maxFraction = fraction;
+                        const fv2 end = from + dir * maxFraction;
+                        segmentBox = { fv2::Min(from, end), fv2::Max(from, end) };
+                    }
+                } else {
+                    stack[top++] = node.child1;
+                    stack[top++] = node.child2;
+                }
+            }
+        }
+    private:
+        u32 AllocateNode();
+        void FreeNode(u32 id);
+
+        void InsertLeaf(u32 leaf);
+        void RemoveLeaf(u32 leaf);
+        void RecalculateUpwards(u32 id);
+        u32 Balance(u32 a);
+
+        static float Perimeter(const fRect2D& box) { return 2 * (box.Width() + box.Height()); }
+    };
+} // Quasi
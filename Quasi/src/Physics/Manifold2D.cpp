@@ -11,55 +11,68 @@ namespace Quasi::Physics2D {
     }
 
     Manifold Manifold::From(const SeperatingAxisSolver& sat) {
-        const Shape&            base = sat.base, & target = sat.target;
-        const PhysicsTransform& bXf  = sat.baseXf, tXf    = sat.targetXf;
-        const fv2& n = sat.seperatingAxis;
+        return FromAxis(sat.base, sat.baseXf, sat.target, sat.targetXf, sat.seperatingAxis);
+    }
 
-        const fLine2D baseClips   = bXf.TransformLine(base  .BestEdgeFor(bXf.TransformInverseDir(n))),
-                      targetClips = tXf.TransformLine(target.BestEdgeFor(tXf.TransformInverseDir(-n)));
+    Manifold Manifold::FromAxis(const Shape& base, const PhysicsTransform& bXf, const Shape& target, const PhysicsTransform& tXf, const fv2& n) {
+        u32 baseIndex, targetIndex;
+        const fLine2D baseEdge   = base  .BestEdgeFor(bXf.TransformInverseDir(n),  baseIndex),
+                      targetEdge = target.BestEdgeFor(tXf.TransformInverseDir(-n), targetIndex);
+        return FromFacingEdges(bXf.TransformLine(baseEdge), tXf.TransformLine(targetEdge), n, baseIndex, targetIndex);
+    }
 
+    Manifold Manifold::FromFacingEdges(const fLine2D& baseClips, const fLine2D& targetClips, const fv2& n, u32 baseIndex, u32 targetIndex) {
         const bool flip = std::abs(baseClips.forward.Dot(n)) > std::abs(targetClips.forward.Dot(n));
         const fLine2D& ref = flip ? targetClips : baseClips, &inc = flip ? baseClips : targetClips;
 
-        Manifold manifold = FromEdges(ref, inc, flip ? n : -n);
+        Manifold manifold = FromEdges(ref, inc, flip ? n : -n,
+                                      flip ? FeatureId(targetIndex, baseIndex, true) : FeatureId(baseIndex, targetIndex, false));
         manifold.seperatingNormal = n;
         // return the valid points
         return manifold;
     }
 
-    Manifold Manifold::FromEdges(const fLine2D& ref, const fLine2D& inc, const fv2& n) {
+    Manifold Manifold::FromEdges(const fLine2D& ref, const fLine2D& inc, const fv2& n, u32 feature) {
         const fv2 refFwd = ref.forward.Norm();
 
-        Manifold manifold = Clip(inc.start, inc.End(), refFwd, refFwd.Dot(ref.start));
+        // clips: 0 and 1 are the incident vertices, 2 and 3 are clipped against the reference start & end
+        const auto clipId = [&] (u32 clip) { return feature | clip << 24; };
+        Manifold manifold = Clip(inc.start, inc.End(), refFwd, refFwd.Dot(ref.start), clipId(0), clipId(1), clipId(2));
 
-        manifold = Clip(manifold.contactPoint[0], manifold.contactPoint[1], -refFwd, -refFwd.Dot(ref.End()));
+        manifold = Clip(manifold.contactPoint[0], manifold.contactPoint[1], -refFwd, -refFwd.Dot(ref.End()),
+                        manifold.contactId[0], manifold.contactId[1], clipId(3));
 
         Manifold result = None();
         const fv2 refNorm = n;
         const float max = ref.start.Dot(refNorm);
 
         if (const float d = refNorm.Dot(manifold.contactPoint[0]) - max; d > 0) {
-            result.AddPoint(manifold.contactPoint[0], d);
+            result.AddPoint(manifold.contactPoint[0], d, manifold.contactId[0]);
         }
         if (const float d = refNorm.Dot(manifold.contactPoint[1]) - max; d > 0) {
-            result.AddPoint(manifold.contactPoint[1], d);
+            result.AddPoint(manifold.contactPoint[1], d, manifold.contactId[1]);
         }
         // return the valid points
         return result;
     }
 
-    Manifold Manifold::Clip(const fv2& v0, const fv2& v1, const fv2& normal, float threshold) {
+    u32 Manifold::FeatureId(u32 refIndex, u32 incIndex, bool flip) {
+        // 12 bits per edge index, then the clip in bits 24-25 and the flip on top
+        return (refIndex & 0xFFF) | (incIndex & 0xFFF) << 12 | (u32)flip << 31;
+    }
+
+    Manifold Manifold::Clip(const fv2& v0, const fv2& v1, const fv2& normal, float threshold, u32 id0, u32 id1, u32 clipId) {
         const float d0 = v0.Dot(normal) - threshold, d1 = v1.Dot(normal) - threshold;
 
         Manifold manifold {};
 
         if (d0 >= 0.0f) // correct sides
-            manifold.AddPoint(v0);
+            manifold.AddPoint(v0, 0, id0);
         if (d1 >= 0.0f) // correct sides
-            manifold.AddPoint(v1);
+            manifold.AddPoint(v1, 0, id1);
 
         if (d0 * d1 < 0.0f) { // different sides
-            manifold.AddPoint(fLine2D { v0, v1 - v0 }.Lerp(d0 / (d0 - d1)));
+            manifold.AddPoint(fLine2D { v0, v1 - v0 }.Lerp(d0 / (d0 - d1)), 0, clipId);
         }
 
         return manifold;
@@ -74,9 +87,10 @@ namespace Quasi::Physics2D {
         return m;
     }
 
-    void Manifold::AddPoint(const fv2& point, float depth) {
+    void Manifold::AddPoint(const fv2& point, float depth, u32 id) {
         contactPoint[contactCount] = point;
         contactDepth[contactCount] = depth;
+        contactId   [contactCount] = id;
         ++contactCount;
     }
 } // Quasi
\ No newline at end of file
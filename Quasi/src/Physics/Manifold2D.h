@@ -4,23 +4,34 @@
 
 namespace Quasi::Physics2D {
     class SeperatingAxisSolver;
+    class Shape;
 
     struct Manifold {
         fv2 seperatingNormal;
         fv2 contactPoint[2];
         float contactDepth[2];
         u32 contactCount = 0;
+        // identifies which features made each point, so contacts can be matched across steps:
+        // the reference edge, the incident edge, which clip made the point, and whether the shapes swapped roles
+        u32 contactId[2] {};
 
         static Manifold None();
 
         static Manifold From(const SeperatingAxisSolver& sat);
-        static Manifold FromEdges(const fLine2D& ref, const fLine2D& inc, const fv2& n);
+        // clips the edges of both shapes that face each other along n, which points from base to target
+        static Manifold FromAxis(const Shape& base, const PhysicsTransform& bXf, const Shape& target, const PhysicsTransform& tXf, const fv2& n);
+        // same as FromAxis, with each shape's best edge along n already found in world space
+        static Manifold FromFacingEdges(const fLine2D& baseEdge, const fLine2D& targetEdge, const fv2& n, u32 baseIndex = 0, u32 targetIndex = 0);
+        // feature is the id shared by every point of this edge pair, see FeatureId
+        static Manifold FromEdges(const fLine2D& ref, const fLine2D& inc, const fv2& n, u32 feature = 0);
+        static u32 FeatureId(u32 refIndex, u32 incIndex, bool flip);
 
         static Manifold Clip(const fv2& v0, const fv2& v1,
-                             const fv2& normal, float threshold);
+                             const fv2& normal, float threshold,
+                             u32 id0 = 0, u32 id1 = 1, u32 clipId = 2);
 
         void Invert();
         static Manifold Flip(Manifold&& m);
-        void AddPoint(const fv2& point, float depth = 0);
+        void AddPoint(const fv2& point, float depth = 0, u32 id = 0);
     };
 } // Quasi
@@ -131,7 +131,7 @@ namespace Quasi::Physics2D {
         return points[furthest];
     }
 
-    fLine2D StaticPolygonShape::BestEdgeFor(const fv2& normal) const {
+    fLine2D StaticPolygonShape::BestEdgeFor(const fv2& normal, Out<u32&> edgeIndex) const {
         float maxDepth = normal.Dot(points[0]);
         i32 furthest = 0;
         for (i32 i = 1; i < size; ++i) {
@@ -145,9 +145,13 @@ namespace Quasi::Physics2D {
         const fv2 &p  = points[furthest],
                    f0 = points[i0] - p,
                    f1 = points[i1] - p;
+        // edge i runs from point i to point i + 1
         if (std::abs(f0.Dot(normal)) * invDists[i0] >
-            std::abs(f1.Dot(normal)) * invDists[i1])
+            std::abs(f1.Dot(normal)) * invDists[furthest]) {
+            edgeIndex = i1;
             return { p, f1 };
+        }
+        edgeIndex = furthest;
         return { p, f0 };
     }
 
@@ -173,10 +177,11 @@ namespace Quasi::Physics2D {
     bool StaticPolygonShape::AddSeperatingAxes(SeperatingAxisSolver& sat) const {
         bool success = false;
         u32 i = 0;
+        // invDists[i] belongs to the edge ending at point i
         for (; i < size - 1; ++i) {
-            success |= sat.CheckAxis((points[i + 1] - points[i]).PerpendLeft() * InvLenBtwn(i));
+            success |= sat.CheckAxis((points[i + 1] - points[i]).PerpendLeft() * InvLenBtwn(i + 1));
         }
-        success |= sat.CheckAxis((points[0] - points[i]).PerpendLeft() * InvLenBtwn(i));
+        success |= sat.CheckAxis((points[0] - points[i]).PerpendLeft() * InvLenBtwn(0));
         return success;
     }
     
@@ -200,7 +205,7 @@ namespace Quasi::Physics2D {
         for (; i < points.Length() - 1; ++i) {
             data.Push({ points[i], points[i + 1].Tangent(points[i]).PerpendRight() });
         }
-        data.Push({ points[i], points[i + 1].Tangent(points[i]).PerpendRight() });
+        data.Push({ points[i], points[0].Tangent(points[i]).PerpendRight() });
     }
 
     void DynPolygonShape::AddPoint(const fv2& p) {
@@ -314,32 +319,46 @@ namespace Quasi::Physics2D {
     }
 
     fv2 DynPolygonShape::FurthestAlong(const fv2& normal) const {
-        u32 furthest = 0;
-        float m = normal.Dot(data[0].pos);
-        for (u32 i = 1; i < data.Length(); ++i) {
-            if (const float d = normal.Dot(data[i].pos); d > m) {
-                m = d;
-                furthest = i;
-            }
+        return data[FurthestIndexFrom(normal, 0)].pos;
+    }
+
+    u32 DynPolygonShape::FurthestIndexFrom(const fv2& normal, u32 start) const {
+        // going around a convex polygon, the projection only rises to one peak and falls back down.
+        // ties keep walking, so flat stretches and repeated points dont stop the climb early
+        const u32 n = data.Length();
+        const float startDepth = normal.Dot(data[start].pos);
+        u32 furthest = start;
+        float m = startDepth;
+        for (u32 i = WrapIndexUp(start), steps = 1; steps < n; i = WrapIndexUp(i), ++steps) {
+            const float d = normal.Dot(data[i].pos);
+            if (d < m) break;
+            m = d;
+            furthest = i;
         }
-        return data[furthest].pos;
-    }
-
-    fLine2D DynPolygonShape::BestEdgeFor(const fv2& normal) const {
-        float maxDepth = normal.Dot(data[0].pos);
-        i32 furthest = 0;
-        for (i32 i = 1; i < data.Length(); ++i) {
-            if (const float d = normal.Dot(data[0].pos); d > maxDepth) {
-                maxDepth = d;
-                furthest = i;
-            }
+        if (m > startDepth) return furthest;
+
+        furthest = start;
+        m = startDepth;
+        for (u32 i = WrapIndexDown(start), steps = 1; steps < n; i = WrapIndexDown(i), ++steps) {
+            const float d = normal.Dot(data[i].pos);
+            if (d < m) break;
+            m = d;
+            furthest = i;
         }
+        return furthest;
+    }
 
+    fLine2D DynPolygonShape::BestEdgeFor(const fv2& normal, Out<u32&> edgeIndex) const {
+        const i32 furthest = (i32)FurthestIndexFrom(normal, 0);
         const i32 i0 = WrapIndexUp(furthest), i1 = WrapIndexDown(furthest);
         const fv2 &p  = data[furthest].pos;
-        if (std::abs(data[i1].nrm.Cross(normal)) >
-            std::abs(data[i1].nrm.Cross(normal)))
+        // the edge whose normal lines up best with the axis is the face, the other one only touches at p
+        if (std::abs(data[i1].nrm.Dot(normal)) >
+            std::abs(data[furthest].nrm.Dot(normal))) {
+            edgeIndex = i1;
             return { p, data[i1].pos - p };
+        }
+        edgeIndex = furthest;
         return { p, data[i0].pos - p };
     }
 
@@ -34,7 +34,7 @@ namespace Quasi::Physics2D {
 
         fv2 NearestPointTo(const fv2& point) const;
         fv2 FurthestAlong(const fv2& normal) const;
-        fLine2D BestEdgeFor(const fv2& normal) const;
+        fLine2D BestEdgeFor(const fv2& normal, Out<u32&> edgeIndex) const;
         fRange ProjectOntoAxis(const fv2& axis) const;
         fRange ProjectOntoOwnAxis(u32 axisID, const fv2& axis) const;
         bool AddSeperatingAxes(SeperatingAxisSolver& sat) const;
@@ -79,7 +79,9 @@ namespace Quasi::Physics2D {
 
         fv2 NearestPointTo(const fv2& point) const;
         fv2 FurthestAlong(const fv2& normal) const;
-        fLine2D BestEdgeFor(const fv2& normal) const;
+        // walks from start towards the furthest point, so a start close to it only takes a few steps
+        u32 FurthestIndexFrom(const fv2& normal, u32 start) const;
+        fLine2D BestEdgeFor(const fv2& normal, Out<u32&> edgeIndex) const;
         fRange ProjectOntoAxis(const fv2& axis) const;
         fRange ProjectOntoOwnAxis(u32 axisID, const fv2& axis) const;
         bool AddSeperatingAxes(SeperatingAxisSolver& sat) const;
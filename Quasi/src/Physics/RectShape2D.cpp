@@ -24,9 +24,11 @@ namespace Quasi::Physics2D {
         return Corner(dx > 0, dy > 0);
     }
 
-    fLine2D RectShape::BestEdgeFor(const fv2& normal) const {
+    fLine2D RectShape::BestEdgeFor(const fv2& normal, Out<u32&> edgeIndex) const {
         const float dx = hx * normal.x, dy = hy * normal.y;
         const bool xPerpendicular = std::abs(dx) < std::abs(dy);
+        // faces are numbered +x, +y, -x, -y
+        edgeIndex = xPerpendicular ? (dy > 0 ? 1 : 3) : (dx > 0 ? 0 : 2);
         return { Corner(dx > 0, dy > 0),
                  xPerpendicular ? fv2 { dx > 0 ? -2 * hx : 2 * hx, 0 }
                                 : fv2 { 0, dy > 0 ? -2 * hy : 2 * hy } };
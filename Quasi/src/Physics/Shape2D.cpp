@@ -8,7 +8,7 @@ namespace Quasi::Physics2D {
     IMPLEMENT_SHAPE_FN(float,    Shape, Inertia,            (), ())
     IMPLEMENT_SHAPE_FN(fv2, Shape, NearestPointTo,     (const fv2& point),            (point))
     IMPLEMENT_SHAPE_FN(fv2, Shape, FurthestAlong,      (const fv2& normal),           (normal))
-    IMPLEMENT_SHAPE_FN(fLine2D,  Shape, BestEdgeFor,        (const fv2& normal),           (normal))
+    IMPLEMENT_SHAPE_FN(fLine2D,  Shape, BestEdgeFor,        (const fv2& normal, Out<u32&> edgeIndex), (normal, edgeIndex))
     IMPLEMENT_SHAPE_FN(fRange,   Shape, ProjectOntoAxis,    (const fv2& axis),             (axis))
     IMPLEMENT_SHAPE_FN(fRange,   Shape, ProjectOntoOwnAxis, (u32 axisID, const fv2& axis), (axisID, axis))
     IMPLEMENT_SHAPE_FN(bool,     Shape, AddSeperatingAxes,  (SeperatingAxisSolver& sat),        (sat))
@@ -35,7 +35,7 @@ namespace Quasi::Physics2D {
 
         fv2 NearestPointTo(const fv2& point) const;
         fv2 FurthestAlong(const fv2& normal) const;
-        fLine2D BestEdgeFor(const fv2& normal) const;
+        fLine2D BestEdgeFor(const fv2& normal, Out<u32&> edgeIndex) const;
         fRange ProjectOntoAxis(const fv2& axis) const;
         fRange ProjectOntoOwnAxis(u32 axisID, const fv2& axis) const;
         bool AddSeperatingAxes(SeperatingAxisSolver& sat) const;
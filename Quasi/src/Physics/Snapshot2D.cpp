@@ -0,0 +1,95 @@
+#include "Snapshot2D.h"
+
+#include <algorithm>
+#include <cstring>
+#include "Shape2D.h"
+
+namespace Quasi::Physics2D {
+    void SnapshotWriter::WriteShape(const Shape& shape) {
+        const IShape::Type type = shape.TypeIndex();
+        Write((u8)type);
+        switch (type) {
+            case IShape::CIRCLE:     Write(shape.AsUnsafe<CircleShape>());        break;
+            case IShape::CAPSULE:    Write(shape.AsUnsafe<CapsuleShape>());       break;
+            case IShape::RECT:       Write(shape.AsUnsafe<RectShape>());          break;
+            case IShape::POLY_SMALL: Write(shape.AsUnsafe<StaticPolygonShape>()); break;
+            case IShape::POLY: {
+                const DynPolygonShape& poly = shape.AsUnsafe<DynPolygonShape>();
+                Write(poly.centroid);
+                WriteSpan(poly.data.AsSpan());
+                break;
+            }
+        }
+    }
+
+    template <class S> static void ReadPlainShape(SnapshotReader& in, Shape& shape) {
+        const S saved = in.Read<S>();
+        if (shape.TypeIndex() == ShapeTypeIndexOf<S>()) shape.AsUnsafe<S>() = saved;
+        else shape = saved;
+    }
+
+    void SnapshotReader::ReadShape(Shape& shape) {
+        switch ((IShape::Type)Read<u8>()) {
+            case IShape::CIRCLE:     ReadPlainShape<CircleShape>       (*this, shape); break;
+            case IShape::CAPSULE:    ReadPlainShape<CapsuleShape>      (*this, shape); break;
+            case IShape::RECT:       ReadPlainShape<RectShape>         (*this, shape); break;
+            case IShape::POLY_SMALL: ReadPlainShape<StaticPolygonShape>(*this, shape); break;
+            case IShape::POLY: {
+                if (shape.TypeIndex() != IShape::POLY) shape = DynPolygonShape {};
+                DynPolygonShape& poly = shape.AsUnsafe<DynPolygonShape>();
+                poly.centroid = Read<fv2>();
+                ReadVec(poly.data);
+                break;
+            }
+        }
+    }
+
+    // deltas start with the full size, the size of the base, and a bit per chunk telling if it changed.
+    // the changed chunks follow in order
+    void WorldSnapshot::MakeDelta(const WorldSnapshot& base, WorldSnapshot& out) const {
+        out.bytes.Clear();
+        out.delta = true;
+        SnapshotWriter w { out.bytes };
+        const u64 size = bytes.Length(), baseSize = base.bytes.Length();
+        w.Write(size);
+        w.Write(baseSize);
+
+        const usize chunkCount = (size + DELTA_CHUNK_SIZE - 1) / DELTA_CHUNK_SIZE;
+        const usize maskOffset = w.Offset();
+        const u64 zero = 0;
+        for (usize i = 0; i < chunkCount; i += 64) w.Write(zero);
+
+        for (usize c = 0; c < chunkCount; ++c) {
+            const usize begin = c * DELTA_CHUNK_SIZE, length = std::min<usize>(DELTA_CHUNK_SIZE, size - begin);
+            // chunks past the end of the base always count as changed
+            if (begin + length <= baseSize && !std::memcmp(bytes.Data() + begin, base.bytes.Data() + begin, length))
+                continue;
+            out.bytes[maskOffset + c / 8] |= (byte)(1 << c % 8);
+            w.WriteBytes(bytes.Data() + begin, length);
+        }
+    }
+
+    bool WorldSnapshot::ApplyDelta(const WorldSnapshot& base, WorldSnapshot& out) const {
+        if (!delta || base.delta) return false;
+        SnapshotReader in { bytes.AsSpan() };
+        const u64 size = in.Read<u64>(), baseSize = in.Read<u64>();
+        if (baseSize != base.bytes.Length()) return false;
+
+        const usize chunkCount = (size + DELTA_CHUNK_SIZE - 1) / DELTA_CHUNK_SIZE;
+        const byte* mask = bytes.Data() + in.Offset();
+        SnapshotReader chunks { bytes.AsSpan(), in.Offset() + (chunkCount + 63) / 64 * sizeof(u64) };
+
+        out.bytes.Clear();
+        out.delta = false;
+        out.bytes.Reserve(size);
+        out.bytes.SetLengthUnsafe(size);
+        for (usize c = 0; c < chunkCount; ++c) {
+            const usize begin = c * DELTA_CHUNK_SIZE, length = std::min<usize>(DELTA_CHUNK_SIZE, size - begin);
+            if (mask[c / 8] >> c % 8 & 1)
+                chunks.ReadBytes(out.bytes.Data() + begin, length);
+            else
+                Memory::MemCopyNoOverlap(out.bytes.Data() + begin, base.bytes.Data() + begin, length);
+        }
+        return true;
+    }
+} // Physics2D
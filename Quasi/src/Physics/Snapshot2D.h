@@ -0,0 +1,98 @@
+#pragma once
+#include <bit>
+#include <type_traits>
+#include "Utils/Memory.h"
+#include "Utils/Span.h"
+#include "Utils/Vec.h"
+
+namespace Quasi::Physics2D {
+    class Shape;
+    class World;
+
+    // appends values to a byte buffer. only trivially copyable types are allowed, they're copied as is
+    class SnapshotWriter {
+        Vec<byte>& out;
+    public:
+        SnapshotWriter(Vec<byte>& out) : out(out) {}
+
+        void WriteBytes(const void* src, usize size) {
+            if (!size) return;
+            out.Reserve(size);
+            Memory::MemCopyNoOverlap(out.Data() + out.Length(), src, size);
+            out.SetLengthUnsafe(out.Length() + size);
+        }
+        template <class T> void Write(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            WriteBytes(&value, sizeof(T));
+        }
+        // the length, then the items
+        template <class T> void WriteSpan(Span<const T> items) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            Write((u32)items.Length());
+            WriteBytes(items.Data(), items.Length() * sizeof(T));
+        }
+        void WriteShape(const Shape& shape);
+
+        usize Offset() const { return out.Length(); }
+    };
+
+    // reads back what a SnapshotWriter wrote, in the same order. nothing is bounds checked,
+    // the buffer is trusted to come from a snapshot
+    class SnapshotReader {
+        Span<const byte> in;
+        usize offset = 0;
+    public:
+        SnapshotReader(Span<const byte> in, usize offset = 0) : in(in), offset(offset) {}
+
+        void ReadBytes(void* dst, usize size) {
+            if (!size) return;
+            Memory::MemCopyNoOverlap(dst, in.Data() + offset, size);
+            offset += size;
+        }
+        template <class T> T Read() {
+            static_assert(std::is_trivially_copyable_v<T>);
+            byte raw[sizeof(T)];
+            ReadBytes(raw, sizeof(T));
+            return std::bit_cast<T>(raw);
+        }
+        // replaces the contents, only allocating when the vec has to grow
+        template <class T> void ReadVec(Vec<T>& items) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const u32 n = Read<u32>();
+            items.Clear();
+            items.Reserve(n);
+            ReadBytes(items.Data(), n * sizeof(T));
+            items.SetLengthUnsafe(n);
+        }
+        // keeps the shape's own storage when it already holds the same kind of shape
+        void ReadShape(Shape& shape);
+
+        usize Offset() const { return offset; }
+        usize Remaining() const { return in.Length() - offset; }
+    };
+
+    // the whole simulation state of a world in one flat buffer.
+    // settings like gravity, solver tuning and triggers aren't part of it.
+    class WorldSnapshot {
+        Vec<byte> bytes;
+        bool delta = false;
+    public:
+        // bumped whenever the layout changes, older snapshots are refused
+        static constexpr u32 FORMAT_VERSION = 1;
+        // deltas store which chunks of this size changed, and only those
+        static constexpr u32 DELTA_CHUNK_SIZE = 64;
+
+        bool IsEmpty() const { return bytes.IsEmpty(); }
+        bool IsDelta() const { return delta; }
+        usize ByteSize() const { return bytes.Length(); }
+        Span<const byte> Bytes() const { return bytes.AsSpan(); }
+
+        // the chunks of this snapshot that differ from base. both have to be full snapshots
+        void MakeDelta(const WorldSnapshot& base, WorldSnapshot& out) const;
+        // rebuilds the full snapshot this delta was made from.
+        // false if base isn't the snapshot it was made against, as far as its size tells
+        bool ApplyDelta(const WorldSnapshot& base, WorldSnapshot& out) const;
+
+        friend class World;
+    };
+} // Physics2D
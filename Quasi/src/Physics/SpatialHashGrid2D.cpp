@@ -0,0 +1,41 @@
+#include "SpatialHashGrid2D.h"
+
+#include <cmath>
+#include "Body2D.h"
+
+namespace Quasi::Physics2D {
+    void SpatialHashGrid::Clear() {
+        proxies.Clear();
+        largeProxies.Clear();
+        entries.Clear();
+        cellHeads.Clear();
+    }
+
+    void SpatialHashGrid::Insert(Body& body) {
+        const u32 id = proxies.Length();
+        const fRect2D& box = body.BoundingBox();
+        const iRect2D cells = { CellOf(box.min), CellOf(box.max) };
+        const iv2 span = cells.max - cells.min + 1;
+
+        if ((u64)span.x * (u64)span.y > MAX_CELLS_PER_PROXY) {
+            // marks it as large by inverting the cell range
+            proxies.Push({ box, { iv2 { 0 }, iv2 { -1 } }, body });
+            largeProxies.Push(id);
+            return;
+        }
+
+        proxies.Push({ box, cells, body });
+        if (entries.IsEmpty()) entries.Push({ NULL_ENTRY, NULL_ENTRY });
+        for (i32 y = cells.min.y; y <= cells.max.y; ++y) {
+            for (i32 x = cells.min.x; x <= cells.max.x; ++x) {
+                u32& head = cellHeads[CellKey(x, y)];
+                entries.Push({ id, head });
+                head = entries.Length() - 1;
+            }
+        }
+    }
+
+    iv2 SpatialHashGrid::CellOf(const fv2& p) const {
+        return { (i32)std::floor(p.x * invCellSize), (i32)std::floor(p.y * invCellSize) };
+    }
+} // Quasi
@@ -0,0 +1,87 @@
+#pragma once
+#include "PhysicsTransform2D.h"
+#include "Utils/HashMap.h"
+#include "Utils/Math/Rect.h"
+#include "Utils/Vec.h"
+
+namespace Quasi::Physics2D {
+    class Body;
+
+    // uniform grid of bodies hashed by cell coordinate, used as a broadphase.
+    // best suited for many bodies of similar size, it is rebuilt every step
+    // and never needs to sort anything.
+    class SpatialHashGrid {
+    public:
+        // bodies covering more cells than this are tested against everything instead
+        static constexpr u32 MAX_CELLS_PER_PROXY = 64;
+        static constexpr u32 NULL_ENTRY = 0; // entry 0 is reserved, so new cells start empty
+
+        struct Proxy {
+            fRect2D box;
+            iRect2D cells; // inclusive
+            Ref<Body> body;
+        };
+
+        struct Entry {
+            u32 proxy, next;
+        };
+    private:
+        Vec<Proxy> proxies;
+        Vec<u32> largeProxies;
+        Vec<Entry> entries;
+        HashMap<u64, u32> cellHeads;
+        float invCellSize = 0.25f;
+    public:
+        SpatialHashGrid() = default;
+        SpatialHashGrid(float cellSize) : invCellSize(1 / cellSize) {}
+
+        float CellSize() const { return 1 / invCellSize; }
+        void SetCellSize(float cellSize) { invCellSize = 1 / cellSize; }
+
+        void Clear();
+        void Insert(Body& body);
+
+        usize ProxyCount() const { return proxies.Length(); }
+        usize CellCount()  const { return cellHeads.Count(); }
+
+        // calls the callback exactly once for every pair of bodies whose boxes overlap
+        void FindPairs(Fn<void, Body&, Body&> auto&& callback) {
+            for (u32 i = 0; i < proxies.Length(); ++i) {
+                Proxy& p = proxies[i];
+                if (p.cells.max.x < p.cells.min.x) continue; // large proxy
+                for (i32 y = p.cells.min.y; y <= p.cells.max.y; ++y) {
+                    for (i32 x = p.cells.min.x; x <= p.cells.max.x; ++x) {
+                        const OptRef<const u32> head = cellHeads.Get(CellKey(x, y));
+                        if (!head) continue;
+                        // entries are prepended, so earlier proxies are at the back
+                        for (u32 e = *head; e != NULL_ENTRY; e = entries[e].next) {
+                            const u32 j = entries[e].proxy;
+                            if (j >= i) continue;
+                            Proxy& q = proxies[j];
+                            if (!p.box.Overlaps(q.box)) continue;
+                            // only report the pair in the cell holding the corner of their overlap
+                            if (CellOf(fv2::Max(p.box.min, q.box.min)) != iv2 { x, y }) continue;
+                            callback(*q.body, *p.body);
+                        }
+                    }
+                }
+            }
+
+            for (u32 li = 0; li < largeProxies.Length(); ++li) {
+                const u32 l = largeProxies[li];
+                Proxy& p = proxies[l];
+                for (u32 j = 0; j < proxies.Length(); ++j) {
+                    if (j == l) continue;
+                    Proxy& q = proxies[j];
+                    // two large proxies get reported by the later of them
+                    if (q.cells.max.x < q.cells.min.x && j > l) continue;
+                    if (p.box.Overlaps(q.box))
+                        callback(*p.body, *q.body);
+                }
+            }
+        }
+    private:
+        iv2 CellOf(const fv2& p) const;
+        static u64 CellKey(i32 x, i32 y) { return (u64)(u32)x << 32 | (u32)y; }
+    };
+} // Quasi
@@ -0,0 +1,253 @@
+#include "TimeOfImpact2D.h"
+
+#include <algorithm>
+#include <cmath>
+#include "Shape2D.h"
+
+namespace Quasi::Physics2D {
+    static constexpr u32 MAX_GJK_ITERATIONS = 20;
+    static constexpr u32 MAX_TOI_ITERATIONS = 20;
+    static constexpr u32 MAX_EPA_ITERATIONS = 32;
+    static constexpr u32 MAX_EPA_VERTICES   = MAX_EPA_ITERATIONS + 3;
+    static constexpr float EPA_TOLERANCE    = 1e-4f;
+
+    // the shape without its rounding, which keeps gjk from crawling along curved surfaces
+    struct ConvexCore {
+        const Shape& shape;
+        const PhysicsTransform& xf;
+        float radius = 0;
+        // big polygons climb from the last support point, which is usually right next to the new one
+        mutable u32 lastSupport = 0;
+
+        ConvexCore(const Shape& shape, const PhysicsTransform& xf) : shape(shape), xf(xf) {
+            switch (shape.TypeIndex()) {
+                case IShape::CIRCLE:  radius = shape.AsUnsafe<CircleShape>() .radius; break;
+                case IShape::CAPSULE: radius = shape.AsUnsafe<CapsuleShape>().radius; break;
+                default:;
+            }
+        }
+
+        fv2 Support(const fv2& dir) const {
+            switch (shape.TypeIndex()) {
+                case IShape::CIRCLE: return xf.position;
+                case IShape::CAPSULE: {
+                    const fv2 forward = xf.TransformDir(shape.AsUnsafe<CapsuleShape>().forward);
+                    return xf.position + (forward.Dot(dir) < 0 ? -forward : forward);
+                }
+                case IShape::POLY: {
+                    const DynPolygonShape& poly = shape.AsUnsafe<DynPolygonShape>();
+                    lastSupport = poly.FurthestIndexFrom(xf.TransformInverseDir(dir), lastSupport);
+                    return xf.Transform(poly.PointAt((i32)lastSupport));
+                }
+                default: return xf.Transform(shape.FurthestAlong(xf.TransformInverseDir(dir)));
+            }
+        }
+    };
+
+    struct SimplexVertex {
+        fv2 a, b, w; // w = b - a
+        float u = 1; // barycentric weight of the closest point
+    };
+
+    // reduces the simplex to the feature closest to the origin
+    static void SolveSimplex(SimplexVertex* v, u32& count) {
+        if (count == 2) {
+            const fv2 e = v[1].w - v[0].w;
+            const float d2 = -v[0].w.Dot(e), d1 = v[1].w.Dot(e);
+            if (d2 <= 0) { v[0].u = 1; count = 1; return; }
+            if (d1 <= 0) { v[0] = v[1]; v[0].u = 1; count = 1; return; }
+            const float inv = 1 / (d1 + d2);
+            v[0].u = d1 * inv;
+            v[1].u = d2 * inv;
+            return;
+        }
+        if (count != 3) return;
+
+        const fv2 &w1 = v[0].w, &w2 = v[1].w, &w3 = v[2].w;
+        const fv2 e12 = w2 - w1, e13 = w3 - w1, e23 = w3 - w2;
+        const float d12_1 = w2.Dot(e12), d12_2 = -w1.Dot(e12);
+        const float d13_1 = w3.Dot(e13), d13_2 = -w1.Dot(e13);
+        const float d23_1 = w3.Dot(e23), d23_2 = -w2.Dot(e23);
+
+        const float n123 = e12.Cross(e13);
+        const float d123_1 = n123 * w2.Cross(w3),
+                    d123_2 = n123 * w3.Cross(w1),
+                    d123_3 = n123 * w1.Cross(w2);
+
+        if (d12_2 <= 0 && d13_2 <= 0) {
+            v[0].u = 1; count = 1;
+        } else if (d12_1 > 0 && d12_2 > 0 && d123_3 <= 0) {
+            const float inv = 1 / (d12_1 + d12_2);
+            v[0].u = d12_1 * inv; v[1].u = d12_2 * inv; count = 2;
+        } else if (d13_1 > 0 && d13_2 > 0 && d123_2 <= 0) {
+            const float inv = 1 / (d13_1 + d13_2);
+            v[0].u = d13_1 * inv; v[2].u = d13_2 * inv; count = 2;
+            v[1] = v[2];
+        } else if (d12_1 <= 0 && d23_2 <= 0) {
+            v[0] = v[1]; v[0].u = 1; count = 1;
+        } else if (d13_1 <= 0 && d23_1 <= 0) {
+            v[0] = v[2]; v[0].u = 1; count = 1;
+        } else if (d23_1 > 0 && d23_2 > 0 && d123_1 <= 0) {
+            const float inv = 1 / (d23_1 + d23_2);
+            v[1].u = d23_1 * inv; v[2].u = d23_2 * inv; count = 2;
+            v[0] = v[2];
+        } else {
+            const float inv = 1 / (d123_1 + d123_2 + d123_3);
+            v[0].u = d123_1 * inv; v[1].u = d123_2 * inv; v[2].u = d123_3 * inv;
+        }
+    }
+
+    // runs gjk on the minkowski difference b - a. true if it ends up around the origin,
+    // otherwise the simplex is left at the feature closest to it
+    static bool SolveGjk(const ConvexCore& coreA, const ConvexCore& coreB, SimplexVertex* v, u32& count) {
+        const auto makeVertex = [&] (const fv2& dir) {
+            const fv2 a = coreA.Support(-dir), b = coreB.Support(dir);
+            return SimplexVertex { a, b, b - a };
+        };
+
+        count = 1;
+        const fv2 start = coreA.xf.position - coreB.xf.position;
+        v[0] = makeVertex(start.LenSq() > 0 ? start : fv2 { 1, 0 });
+
+        fv2 closest = v[0].w;
+        for (u32 iter = 0; iter < MAX_GJK_ITERATIONS; ++iter) {
+            SolveSimplex(v, count);
+            closest = 0;
+            for (u32 i = 0; i < count; ++i) closest += v[i].w * v[i].u;
+            // the origin is inside, so the cores overlap
+            if (count == 3 || closest.LenSq() < f32s::DELTA * f32s::DELTA) return true;
+
+            const SimplexVertex next = makeVertex(-closest);
+            bool duplicate = false;
+            for (u32 i = 0; i < count; ++i) duplicate |= v[i].w == next.w;
+            // stop once the new support point gets no closer to the origin
+            if (duplicate || closest.Dot(closest - next.w) <= f32s::DELTA * closest.Len()) break;
+
+            v[count++] = next;
+            if (iter + 1 == MAX_GJK_ITERATIONS) {
+                SolveSimplex(v, count);
+                if (count == 3) return true;
+            }
+        }
+        return false;
+    }
+
+    DistanceResult ShapeDistance(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2) {
+        const ConvexCore coreA { s1, xf1 }, coreB { s2, xf2 };
+        SimplexVertex v[3];
+        u32 count = 0;
+        if (SolveGjk(coreA, coreB, v, count)) return {};
+
+        DistanceResult result;
+        result.pointA = 0; result.pointB = 0;
+        for (u32 i = 0; i < count; ++i) {
+            result.pointA += v[i].a * v[i].u;
+            result.pointB += v[i].b * v[i].u;
+        }
+        const float coreDistance = result.pointA.Dist(result.pointB);
+        result.normal = (result.pointB - result.pointA) / coreDistance;
+        result.distance = coreDistance - coreA.radius - coreB.radius;
+        if (result.distance <= 0) {
+            result.pointA = result.pointB = (result.pointA + result.pointB) * 0.5f;
+            result.distance = 0;
+            return result;
+        }
+        result.pointA += result.normal * coreA.radius;
+        result.pointB -= result.normal * coreB.radius;
+        return result;
+    }
+
+    bool CoresOverlap(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2) {
+        const ConvexCore coreA { s1, xf1 }, coreB { s2, xf2 };
+        SimplexVertex v[3];
+        u32 count = 0;
+        return SolveGjk(coreA, coreB, v, count);
+    }
+
+    PenetrationResult ShapePenetration(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2) {
+        const ConvexCore coreA { s1, xf1 }, coreB { s2, xf2 };
+        SimplexVertex v[3];
+        u32 count = 0;
+        // a simplex short of a triangle only means the cores are just touching
+        if (!SolveGjk(coreA, coreB, v, count) || count < 3) return {};
+
+        // epa: keep pushing out the edge of the difference closest to the origin
+        // until it can't go any further, that edge is the shallowest way out
+        fv2 points[MAX_EPA_VERTICES], normals[MAX_EPA_VERTICES];
+        float dists[MAX_EPA_VERTICES];
+        u32 size = 3;
+        const float area = (v[1].w - v[0].w).Cross(v[2].w - v[0].w);
+        if (std::abs(area) <= f32s::DELTA) return {};
+        points[0] = v[0].w;
+        points[1] = area > 0 ? v[1].w : v[2].w;
+        points[2] = area > 0 ? v[2].w : v[1].w;
+
+        // counter clockwise, so the outward normal is on the right of each edge
+        const auto setEdge = [&] (u32 i) {
+            const fv2 e = points[i + 1 == size ? 0 : i + 1] - points[i];
+            const float len = e.Len();
+            normals[i] = len > 0 ? e.PerpendRight() / len : fv2 { 0, 0 };
+            dists[i]   = len > 0 ? normals[i].Dot(points[i]) : f32s::INFINITY;
+        };
+        for (u32 i = 0; i < 3; ++i) setEdge(i);
+
+        for (u32 iter = 0; iter < MAX_EPA_ITERATIONS; ++iter) {
+            u32 closest = 0;
+            for (u32 i = 1; i < size; ++i)
+                if (dists[i] < dists[closest]) closest = i;
+
+            const fv2& n = normals[closest];
+            const fv2 w = coreB.Support(n) - coreA.Support(-n);
+            if (w.Dot(n) - dists[closest] <= EPA_TOLERANCE * std::max(1.0f, dists[closest]) || size == MAX_EPA_VERTICES)
+                break;
+
+            for (u32 i = size; i > closest + 1; --i) {
+                points[i] = points[i - 1];
+                normals[i] = normals[i - 1];
+                dists[i] = dists[i - 1];
+            }
+            points[closest + 1] = w;
+            ++size;
+            setEdge(closest);
+            setEdge(closest + 1);
+        }
+
+        u32 closest = 0;
+        for (u32 i = 1; i < size; ++i)
+            if (dists[i] < dists[closest]) closest = i;
+        // moving b against the edge normal is what takes the origin out of b - a
+        return { std::max(dists[closest], 0.0f), -normals[closest], true };
+    }
+
+    TimeOfImpactResult TimeOfImpact(const Shape& s1, const Sweep& sweep, const Shape& s2, const PhysicsTransform& xf2, float targetSeparation) {
+        float tolerance = std::max(0.25f * targetSeparation, f32s::DELTA);
+
+        DistanceResult dist = ShapeDistance(s1, sweep.start, s2, xf2);
+        if (dist.distance <= 0) return {};
+        if (dist.distance <= targetSeparation + tolerance) {
+            // already touching, so pushing in is an immediate hit
+            const fv2 pointMotion = sweep.translation + (dist.pointA - sweep.start.position).Perpend() * sweep.rotation;
+            if (pointMotion.Dot(dist.normal) > tolerance)
+                return { 0, (dist.pointA + dist.pointB) * 0.5f, dist.normal, true };
+            // sliding or spinning along the surface, only stop it from going through
+            targetSeparation = dist.distance * 0.5f;
+            tolerance = std::min(tolerance, targetSeparation * 0.5f);
+        }
+
+        float t = 0;
+        fv2 normal = dist.normal;
+        for (u32 iter = 0; iter < MAX_TOI_ITERATIONS; ++iter) {
+            // no point of the shape closes the gap faster than this
+            const float approach = sweep.translation.Dot(normal) + std::abs(sweep.rotation) * sweep.boundRadius;
+            if (approach <= 0) return {};
+
+            t += (dist.distance - targetSeparation) / approach;
+            if (t >= 1) return {};
+
+            dist = ShapeDistance(s1, sweep.At(t), s2, xf2);
+            if (dist.distance > 0) normal = dist.normal;
+            if (dist.distance <= targetSeparation + tolerance) break;
+        }
+        return { t, (dist.pointA + dist.pointB) * 0.5f, normal, true };
+    }
+} // Physics2D
@@ -0,0 +1,50 @@
+#pragma once
+#include "PhysicsTransform2D.h"
+
+namespace Quasi::Physics2D {
+    class Shape;
+
+    struct DistanceResult {
+        float distance = 0;    // 0 when the shapes overlap
+        fv2 pointA, pointB;    // closest points on each shape's surface
+        fv2 normal;            // points from A to B, only valid when distance > 0
+    };
+
+    // gjk distance between the convex cores of two shapes.
+    // circles and capsules are handled as a point or segment plus their radius.
+    DistanceResult ShapeDistance(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2);
+    // just the gjk intersection test, without working out any distances
+    bool CoresOverlap(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2);
+
+    struct PenetrationResult {
+        float depth = 0; // how far B has to move along the normal to stop overlapping A
+        fv2 normal;      // points from A to B
+        bool overlaps = false;
+    };
+
+    // gjk to find the overlap, then epa to find the shallowest way out of it.
+    // only the cores are pushed apart, so it's meant for polygons. cores that are
+    // just touching don't count as overlapping
+    PenetrationResult ShapePenetration(const Shape& s1, const PhysicsTransform& xf1, const Shape& s2, const PhysicsTransform& xf2);
+
+    // a body's motion over one step
+    struct Sweep {
+        PhysicsTransform start;
+        fv2 translation;
+        float rotation = 0;    // radians
+        float boundRadius = 0; // furthest any point of the shape gets from its center
+
+        PhysicsTransform At(float t) const { return { start.position + translation * t, start.rotation + Rotor2D { Radians(rotation * t) } }; }
+    };
+
+    struct TimeOfImpactResult {
+        float time = 1;  // fraction of the sweep, 1 if nothing was hit
+        fv2 point, normal; // normal points from the moving shape to the hit one
+        bool hit = false;
+    };
+
+    // conservative advancement of s1 along the sweep until it comes within targetSeparation of s2.
+    // shapes already that close at the start hit immediately if they keep moving into each other,
+    // overlapping ones are left to the regular contacts.
+    TimeOfImpactResult TimeOfImpact(const Shape& s1, const Sweep& sweep, const Shape& s2, const PhysicsTransform& xf2, float targetSeparation);
+} // Physics2D
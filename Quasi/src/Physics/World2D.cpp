@@ -1,20 +1,46 @@
 #include "World2D.h"
 
+#include <chrono>
 #include "Utils/Algorithm.h"
 
 namespace Quasi::Physics2D {
+    using StatsClock = std::chrono::steady_clock;
+
+    // milliseconds since the last lap, then starts the next one
+    static float Lap(StatsClock::time_point& last) {
+        const StatsClock::time_point now = StatsClock::now();
+        const float ms = std::chrono::duration<float, std::milli>(now - last).count();
+        last = now;
+        return ms;
+    }
+
     void World::Reserve(usize size) {
         bodies.Reserve(size);
+        storage.Reserve(size);
     }
 
     void World::Clear() {
         bodies.Clear();
+        storage.Clear();
+        bulletCount = 0;
+        tree.Clear();
+        staticTree.Clear();
+        proxyPairs.Clear();
+        proxyPairLookup.Clear();
+        grid.Clear();
+        sweepOrderStale = true;
+        substepPairsStale = true;
+        solver.Clear();
+        collisionEvents.Clear();
     }
 
     Body& World::CreateBody(const BodyCreateOptions& options, Shape shape) {
         const float area = shape.ComputeArea();
         const bool isStatic = options.type == BodyType::STATIC;
-        return *bodies.Push(Box<Body>::Build(
+        const BodyHandle handle = storage.Allocate();
+        Body& body = *bodies.Push(Box<Body>::Build(
+            handle,
+            storage.Length() - 1,
             options.position,
             Degrees(options.rotAngle),
             isStatic ? 0 : area * options.density,
@@ -22,6 +48,11 @@ namespace Quasi::Physics2D {
             *this,
             std::move(shape)
         ));
+        if (options.bullet) body.SetBullet(true);
+        CreateProxy(body);
+        if (!sweepOrderStale && !body.IsStatic()) sweepOrder.Push(body.index);
+        substepPairsStale = true;
+        return body;
     }
 
     Body& World::CreatePolygon(const BodyCreateOptions& options, Span<const fv2> points) {
@@ -31,7 +62,7 @@ namespace Quasi::Physics2D {
             const fv2 cen = shape.CalcCentroid();
             shape.FixCentroid(cen);
             Body& b = CreateBody(options, Shape(shape));
-            b.position += cen;
+            b.Teleport(b.Position() + cen);
             return b;
         } else {
             DynPolygonShape shape;
@@ -39,62 +70,180 @@ namespace Quasi::Physics2D {
             const fv2 cen = shape.CalcCentroid();
             shape.FixCentroid(cen);
             Body& b = CreateBody(options, Shape(shape));
-            b.position += cen;
+            b.Teleport(b.Position() + cen);
             return b;
         }
     }
 
     void World::DeleteBody(usize i) {
-        bodies.Pop(i);
+        solver.RemoveBody(*bodies[i]);
+        DestroyProxy(*bodies[i]);
+        bodies[i]->SetBullet(false);
+        RemoveFromSweep(i);
+        substepPairsStale = true;
+        storage.Remove(i);
+        bodies.PopUnordered(i);
+        if (i < bodies.Length())
+            bodies[i]->index = i;
     }
 
     void World::DeleteBody(Ref<Body> body) {
-        const OptionUsize i = bodies.FindIf([=] (const Box<Body>& b) { return b.RefEquals(body); });
-        if (!i) return;
-        bodies.Pop(*i);
+        const u32 i = body->index;
+        if (i >= bodies.Length() || !bodies[i].RefEquals(body)) return;
+        DeleteBody(i);
     }
 
-    void World::Update(float dt) {
-        for (Body* b : bodies) {
-            if (!b->enabled) continue;
+    void World::DeleteBody(BodyHandle handle) {
+        const u32 i = storage.IndexOf(handle);
+        if (i == BodyStorage::NULL_INDEX) return;
+        DeleteBody(i);
+    }
+
+    OptRef<Body> World::Get(BodyHandle handle) {
+        return QGetterMut$(Get, handle);
+    }
+
+    OptRef<const Body> World::Get(BodyHandle handle) const {
+        const u32 i = storage.IndexOf(handle);
+        return i != BodyStorage::NULL_INDEX ? OptRefs::SomeRef(*bodies[i]) : nullptr;
+    }
+
+    void World::SetBroadphase(BroadphaseMode mode) {
+        if (broadphase == mode) return;
+        if (broadphase == BroadphaseMode::DYNAMIC_TREE) {
+            proxyPairs.Clear();
+            proxyPairLookup.Clear();
+        }
+        grid.Clear();
+        sweepOrderStale = true;
+        substepPairsStale = true;
+
+        broadphase = mode;
+        if (mode == BroadphaseMode::DYNAMIC_TREE) {
+            // pairs are only searched for around moved proxies, so rebuild to count everything as moved
+            tree.Clear();
+            queryTreeStale = false;
+            for (Body* b : bodies) {
+                if (b->IsStatic()) continue;
+                b->proxyId = DynamicTree::NULL_NODE;
+                CreateProxy(*b);
+            }
+        }
+    }
+
+    void World::SetWorkerThreads(u32 count) {
+        if (count == WorkerThreads()) return;
+        threadPool = count ? Box<ThreadPool>::Build(count) : Box<ThreadPool>::Empty();
+    }
+
+    void World::CreateProxy(Body& body) {
+        body.TryUpdateTransforms();
+        body.proxyId = ProxyTreeOf(body).CreateProxy(body.BoundingBox(), body);
+        if (body.IsStatic()) staticTree.ClearMoved();
+    }
 
-            if (b->type == BodyType::DYNAMIC)
-                b->velocity += gravity * dt;
-            b->Update(dt);
+    void World::DestroyProxy(Body& body) {
+        if (body.proxyId == DynamicTree::NULL_NODE) return;
+        const u32 proxy = body.proxyId;
+        body.proxyId = DynamicTree::NULL_NODE;
+        if (body.IsStatic()) {
+            staticTree.DestroyProxy(proxy);
+            return;
         }
 
+        for (u32 i = 0; i < proxyPairs.Length();) {
+            const ProxyPair& pair = proxyPairs[i];
+            if (pair.proxyA == proxy || pair.proxyB == proxy) {
+                proxyPairLookup.Remove(PairKey(pair.proxyA, pair.proxyB));
+                proxyPairs.PopUnordered(i);
+                if (i < proxyPairs.Length())
+                    proxyPairLookup[PairKey(proxyPairs[i].proxyA, proxyPairs[i].proxyB)] = i;
+            } else ++i;
+        }
+        tree.DestroyProxy(proxy);
+    }
 
-        bodies.SortByKey([&] (const Box<Body>& b) { return b->boundingBox.min.x; });
-        // std::ranges::sort(bodyIndicesSorted, [&](u32 i, u32 j) { return cmpr(bodies[i]) < cmpr(bodies[j]); });
+    void World::RefitProxy(Body& body) {
+        if (body.IsStatic()) {
+            // only happens when a static body is teleported, nothing tracks what moved in here
+            staticTree.MoveProxy(body.proxyId, body.BoundingBox());
+            staticTree.ClearMoved();
+        } else {
+            tree.MoveProxy(body.proxyId, body.BoundingBox());
+        }
+    }
 
-        // sweep impl
-        // std::vector<std::tuple<Body*, Body*, Collision::Event>> collisionPairs;
-        Vec<Ref<Body>> active;
+    void World::SetBodyType(Body& body, BodyType type) {
+        const bool staticChanged = body.IsStatic() != (type == BodyType::STATIC);
+        if (staticChanged) DestroyProxy(body);
+        body.type = type;
+        if (staticChanged) {
+            CreateProxy(body);
+            sweepOrderStale = true;
+        }
+        substepPairsStale = true;
+    }
+
+    void World::SyncQueryTree() {
+        if (!queryTreeStale) return;
         for (Body* b : bodies) {
-            if (!b->enabled) continue;
-            const float min = b->boundingBox.min.x;
-            for (u32 j = 0; j < active.Length();) {
-                Body* c = active[j].Address();
-                if (c->boundingBox.max.x > min) {
-                    const bool bDyn = b->IsDynamic(), cDyn = c->IsDynamic();
-                    if ((bDyn || cDyn) && c->boundingBox.RangeY().Overlaps(b->boundingBox.RangeY())) {
-                        const Manifold manifold = b->CollideWith(*c);
-                        if (manifold.contactCount && std::max(manifold.contactDepth[0], manifold.contactDepth[1]) > f32s::DELTA) {
-                            b->TryCallTrigger(*c, EventType::HIT);
-                            c->TryCallTrigger(*b, EventType::HIT);
-                            StaticResolve (*b, *c, manifold);
-                            DynamicResolve(*b, *c, manifold);
-                            if (bDyn) b->TryUpdateTransforms();
-                            if (cDyn) c->TryUpdateTransforms();
-                        }
-                    }
-                    ++j;
-                } else {
-                    active.PopUnordered(j);
-                }
-            }
-            active.Push(*b);
+            if (!b->IsStatic()) RefitProxy(*b);
         }
+        // nothing reads the moved list outside of tree mode
+        tree.ClearMoved();
+        queryTreeStale = false;
+    }
+
+    void World::Update(float dt) {
+        StatsClock::time_point start = StatsClock::now();
+        stats = {};
+        Step(dt, true);
+        PublishCollisionEvents();
+        FinishStats(Lap(start));
+        CallTriggers();
+    }
+
+    void World::Step(float dt, bool findPairs) {
+        StatsClock::time_point lap = StatsClock::now();
+        storage.IntegrateVelocities(gravity, dt);
+        stats.integrateMs += Lap(lap);
+
+        solver.BeginContacts();
+        candidatePairs.Clear();
+        if (findPairs) {
+            RunBroadphase();
+            ++stats.broadphaseRuns;
+        } else CollideSubstepPairs();
+        stats.candidatePairs += candidatePairs.Length();
+        stats.broadphaseMs += Lap(lap);
+
+        CollideCandidatePairs();
+        stats.narrowphaseMs += Lap(lap);
+
+        solver.EndContacts();
+        stats.solvedContacts += solver.ContactCount();
+        solver.Solve(dt, OptRef<ThreadPool>::Deref(threadPool.Data()));
+        stats.solverIslands += solver.IslandCount();
+        stats.resolveMs += Lap(lap);
+
+        GatherBullets(dt);
+        stats.bulletMs += Lap(lap);
+        storage.IntegratePositions(dt);
+        storage.UpdateBoxes();
+        stats.integrateMs += Lap(lap);
+        SolveBullets(dt);
+        stats.bulletMs += Lap(lap);
+
+        if (broadphase == BroadphaseMode::DYNAMIC_TREE) {
+            for (u32 i = 0; i < bodies.Length(); ++i) {
+                if (storage.motionScales[i] != 0) RefitProxy(*bodies[i]);
+            }
+        } else queryTreeStale = true;
+        stats.broadphaseMs += Lap(lap);
+
+        if (allowSleep) UpdateSleep(dt);
+        stats.sleepMs += Lap(lap);
+        ++stats.steps;
 
         // for (const auto& [base, target, event] : collisionPairs) {
         //     StaticResolve (*base, *target, event);
@@ -117,10 +266,661 @@ namespace Quasi::Physics2D {
         // }
     }
 
+    void World::RunBroadphase() {
+        switch (broadphase) {
+            case BroadphaseMode::SORT_AND_SWEEP: UpdateSortAndSweep(); break;
+            case BroadphaseMode::DYNAMIC_TREE:   UpdateDynamicTree();  break;
+            case BroadphaseMode::SPATIAL_HASH:   UpdateSpatialHash();  break;
+            default:;
+        }
+        FindStaticPairs();
+    }
+
+    void World::FindStaticPairs() {
+        if (staticTree.ProxyCount() == 0) return;
+        for (Body* b : bodies) {
+            if (b->IsStatic() || !b->IsEnabled()) continue;
+            const fRect2D& box = b->BoundingBox();
+            staticTree.Query(box, [&] (u32 proxy) {
+                Body& other = staticTree.BodyOf(proxy);
+                if (other.IsEnabled() && other.BoundingBox().Overlaps(box))
+                    AddCandidatePair(*b, other);
+                return true;
+            });
+        }
+    }
+
+    fRect2D World::SubstepBox(u32 index, float time) const {
+        fRect2D box = storage.boxes[index];
+        if (storage.motionScales[index] == 0) return box.Extrude(substepPairMargin);
+
+        if (storage.angularVelocities[index] != 0) {
+            // any rotation stays within the circle through the base box's furthest corner
+            const fRect2D& base = storage.baseBoxes[index];
+            const float radius = std::sqrt(std::max(base.min.x * base.min.x, base.max.x * base.max.x) +
+                                           std::max(base.min.y * base.min.y, base.max.y * base.max.y));
+            const fv2& center = storage.positions[index];
+            box = box.Union({ center - radius, center + radius });
+        }
+        const fv2 motion = (storage.velocities[index] + gravity * (0.5f * time * storage.gravityScales[index])) * time;
+        return box.Union(box + motion).Extrude(substepPairMargin);
+    }
+
+    void World::FindSubstepPairs(float time) {
+        StatsClock::time_point lap = StatsClock::now();
+        substepBoxes.Resize(bodies.Length());
+        for (u32 i = 0; i < bodies.Length(); ++i) substepBoxes[i] = SubstepBox(i, time);
+
+        // every broadphase reads the body boxes, so run it over the swept ones instead
+        std::swap(storage.boxes, substepBoxes);
+        if (broadphase == BroadphaseMode::DYNAMIC_TREE) {
+            for (Body* b : bodies) {
+                if (!b->IsStatic()) RefitProxy(*b);
+            }
+        }
+        substepPairs.Clear();
+        findingSubstepPairs = true;
+        RunBroadphase();
+        findingSubstepPairs = false;
+        std::swap(storage.boxes, substepBoxes);
+        substepPairsStale = false;
+        ++stats.broadphaseRuns;
+        stats.broadphaseMs += Lap(lap);
+    }
+
+    void World::FinishStats(float totalMs) {
+        stats.totalMs = totalMs;
+        for (const float scale : storage.motionScales) stats.awakeBodies += scale != 0;
+    }
+
+    void World::PublishCollisionEvents() {
+        collisionEvents.Clear();
+        if (reportCollisionEvents) {
+            // the solver's contacts already persist across steps, so they make up the touching set
+            for (const EndedContact& ended : solver.EndedContacts()) {
+                // touched and let go within one update
+                if (ended.wasNew) collisionEvents.Push({ ended.body, ended.target, EventType::ENTER });
+                collisionEvents.Push({ ended.body, ended.target, EventType::EXIT });
+            }
+            for (const ContactConstraint& c : solver.Contacts())
+                collisionEvents.Push({ c.body->Handle(), c.target->Handle(), c.isNew ? EventType::ENTER : EventType::HIT });
+            stats.collisionEvents = collisionEvents.Length();
+        }
+        solver.ClearContactEvents();
+    }
+
+    void World::CallTriggers() {
+        // triggers can delete bodies, so both sides are looked up again before each call
+        for (u32 i = 0; i < collisionEvents.Length(); ++i) {
+            const CollisionEvent event = collisionEvents[i];
+            if (OptRef<Body> b = Get(event.body), c = Get(event.target); b && c)
+                b->TryCallTrigger(*c, event.type);
+            if (OptRef<Body> b = Get(event.body), c = Get(event.target); b && c)
+                c->TryCallTrigger(*b, event.type);
+        }
+    }
+
+    bool World::SubstepBoxesHold() const {
+        for (u32 i = 0; i < bodies.Length(); ++i)
+            if (!substepBoxes[i].Contains(storage.boxes[i])) return false;
+        return true;
+    }
+
+    void World::CollideSubstepPairs() {
+        for (BodyPair& pair : substepPairs) {
+            if (pair.body->BoundingBox().Overlaps(pair.target->BoundingBox()))
+                AddCandidatePair(*pair.body, *pair.target);
+        }
+    }
+
+    void World::SortSweepAxis() {
+        const Span<const fRect2D> boxes = storage.boxes.AsSpan();
+        // static bodies are found through their own tree instead
+        if (sweepOrderStale) {
+            sweepOrder.Clear();
+            for (u32 i = 0; i < bodies.Length(); ++i)
+                if (!bodies[i]->IsStatic()) sweepOrder.Push(i);
+            sweepOrderStale = false;
+        }
+
+        const u32 n = sweepOrder.Length();
+        sweepKeys.Resize(n);
+        for (u32 k = 0; k < n; ++k) sweepKeys[k] = boxes[sweepOrder[k]].min.x;
+
+        // the order from last step is usually almost right, which makes insertion sort close to linear.
+        // once it has shifted too much the order is scrambled, so radix sort the rest instead
+        const usize shiftBudget = (usize)n * MAX_SWEEP_SHIFTS_PER_BODY;
+        usize shifts = 0;
+        for (u32 k = 1; k < n; ++k) {
+            const float key = sweepKeys[k];
+            const u32 id = sweepOrder[k];
+            u32 j = k;
+            for (; j > 0 && sweepKeys[j - 1] > key; --j) {
+                sweepKeys[j]  = sweepKeys[j - 1];
+                sweepOrder[j] = sweepOrder[j - 1];
+            }
+            sweepKeys[j]  = key;
+            sweepOrder[j] = id;
+
+            shifts += k - j;
+            if (shifts > shiftBudget) {
+                RadixSortSweepAxis();
+                return;
+            }
+        }
+    }
+
+    void World::RadixSortSweepAxis() {
+        const u32 n = sweepOrder.Length();
+        // flipping the sign bit of positives and every bit of negatives orders float bits as unsigned ints
+        Vec<u32>& bits = sweepScratch[0];
+        bits.Resize(n);
+        for (u32 k = 0; k < n; ++k) {
+            const u32 b = f32s::BitsOf(sweepKeys[k]);
+            bits[k] = b ^ ((u32)-(i32)(b >> 31) | 0x8000'0000);
+        }
+
+        Vec<u32>& nextBits = sweepScratch[1], &nextOrder = sweepScratch[2];
+        nextBits.Resize(n);
+        nextOrder.Resize(n);
+        for (u32 shift = 0; shift < 32; shift += 8) {
+            u32 offsets[256] {};
+            for (u32 k = 0; k < n; ++k) ++offsets[bits[k] >> shift & 0xFF];
+            for (u32 d = 0, sum = 0; d < 256; ++d) {
+                const u32 count = offsets[d];
+                offsets[d] = sum;
+                sum += count;
+            }
+            for (u32 k = 0; k < n; ++k) {
+                const u32 dst = offsets[bits[k] >> shift & 0xFF]++;
+                nextBits[dst]  = bits[k];
+                nextOrder[dst] = sweepOrder[k];
+            }
+            std::swap(bits, nextBits);
+            std::swap(sweepOrder, nextOrder);
+        }
+    }
+
+    void World::RemoveFromSweep(u32 index) {
+        if (sweepOrderStale) return;
+        // the last body is about to be moved into the removed one's slot
+        const u32 last = bodies.Length() - 1;
+        u32 kept = 0;
+        for (const u32 id : sweepOrder) {
+            if (id == index) continue;
+            sweepOrder[kept++] = id == last ? index : id;
+        }
+        sweepOrder.Truncate(kept);
+    }
+
+    void World::UpdateSortAndSweep() {
+        const Span<const fRect2D> boxes = storage.boxes.AsSpan();
+        SortSweepAxis();
+
+        // sweep impl
+        Vec<u32> active;
+        for (const u32 i : sweepOrder) {
+            if (!bodies[i]->IsEnabled()) continue;
+            const fRect2D& box = boxes[i];
+            for (u32 j = 0; j < active.Length();) {
+                const fRect2D& other = boxes[active[j]];
+                if (other.max.x > box.min.x) {
+                    if (other.RangeY().Overlaps(box.RangeY()))
+                        AddCandidatePair(*bodies[i], *bodies[active[j]]);
+                    ++j;
+                } else {
+                    active.PopUnordered(j);
+                }
+            }
+            active.Push(i);
+            stats.maxSweepActive = std::max(stats.maxSweepActive, (u32)active.Length());
+        }
+    }
+
+    void World::UpdateDynamicTree() {
+        FindNewTreePairs();
+
+        for (u32 i = 0; i < proxyPairs.Length();) {
+            const ProxyPair pair = proxyPairs[i];
+            if (!tree.FatBoxOf(pair.proxyA).Overlaps(tree.FatBoxOf(pair.proxyB))) {
+                proxyPairLookup.Remove(PairKey(pair.proxyA, pair.proxyB));
+                proxyPairs.PopUnordered(i);
+                if (i < proxyPairs.Length())
+                    proxyPairLookup[PairKey(proxyPairs[i].proxyA, proxyPairs[i].proxyB)] = i;
+                continue;
+            }
+            ++i;
+
+            Body& b = tree.BodyOf(pair.proxyA), &c = tree.BodyOf(pair.proxyB);
+            if (!b.IsEnabled() || !c.IsEnabled()) continue;
+            if (b.BoundingBox().Overlaps(c.BoundingBox()))
+                AddCandidatePair(b, c);
+        }
+    }
+
+    void World::UpdateSpatialHash() {
+        grid.Clear();
+        for (Body* b : bodies) {
+            if (b->IsEnabled() && !b->IsStatic()) grid.Insert(*b);
+        }
+        grid.FindPairs([&] (Body& b, Body& c) { AddCandidatePair(b, c); });
+    }
+
+    void World::FindNewTreePairs() {
+        for (const u32 proxy : tree.MovedProxies()) {
+            tree.Query(tree.FatBoxOf(proxy), [&] (u32 other) {
+                if (other == proxy) return true;
+                // both moved, so only the smaller proxy reports this pair
+                if (tree.WasMoved(other) && other < proxy) return true;
+
+                const u64 key = PairKey(proxy, other);
+                if (proxyPairLookup.Contains(key)) return true;
+
+                proxyPairLookup.Insert(key, (u32)proxyPairs.Length());
+                proxyPairs.Push({ proxy, other });
+                return true;
+            });
+        }
+        tree.ClearMoved();
+    }
+
+    void World::AddCandidatePair(Body& b, Body& c) {
+        if (!b.IsDynamic() && !c.IsDynamic()) return;
+        if (findingSubstepPairs) {
+            substepPairs.Push({ b, c });
+            return;
+        }
+        if (!b.awake && !c.awake) {
+            solver.KeepContact(b, c);
+            return;
+        }
+        candidatePairs.Push({ b, c });
+    }
+
+    void World::CollideCandidatePairs() {
+        // manifolds only depend on the two bodies, so they can be computed in any order
+        candidateManifolds.Clear();
+        candidateManifolds.Resize(candidatePairs.Length());
+
+        // polygons are moved into world space once per step rather than once per pair
+        worldPolygonSlots.Clear();
+        worldPolygonSlots.Resize(bodies.Length());
+        worldPolygonPoints.Clear();
+        worldPolygonNormals.Clear();
+        const auto cachePolygon = [&] (const Body& b) {
+            WorldPolygonSlot& slot = worldPolygonSlots[b.Index()];
+            if (slot.count) return;
+            slot.start = worldPolygonPoints.Length();
+            TransformPolygon(b.shape, b.GetTransform(), worldPolygonPoints, worldPolygonNormals);
+            slot.count = worldPolygonPoints.Length() - slot.start;
+        };
+
+        // circles against circles or rects go into batches, everything else is collided pair by pair
+        circlePairIndices.Clear();
+        circleRectPairIndices.Clear();
+        otherPairIndices.Clear();
+        for (u32 i = 0; i < candidatePairs.Length(); ++i) {
+            const Body& b = *candidatePairs[i].body, &c = *candidatePairs[i].target;
+            const IShape::Type bt = b.shape.TypeIndex(), ct = c.shape.TypeIndex();
+            if (bt == IShape::CIRCLE && ct == IShape::CIRCLE) {
+                circlePairIndices.Push(i);
+            } else if ((bt == IShape::CIRCLE && ct == IShape::RECT) || (bt == IShape::RECT && ct == IShape::CIRCLE)) {
+                circleRectPairIndices.Push(i);
+            } else {
+                if (CollidesAsWorldPolygons(b.shape, c.shape)) {
+                    cachePolygon(b);
+                    cachePolygon(c);
+                }
+                otherPairIndices.Push(i);
+            }
+        }
+        circleBatch.Resize(circlePairIndices.Length());
+        circleRectBatch.Resize(circleRectPairIndices.Length());
+
+        const auto worldPolygonOf = [&] (const Body& b) {
+            const WorldPolygonSlot& slot = worldPolygonSlots[b.Index()];
+            return WorldPolygon { worldPolygonPoints .AsSpan().Subspan(slot.start, slot.count),
+                                  worldPolygonNormals.AsSpan().Subspan(slot.start, slot.count) };
+        };
+
+        const auto collide = [&] (u32 begin, u32 end) {
+            for (u32 k = begin; k < end; ++k) {
+                const u32 i = otherPairIndices[k];
+                const Body& b = *candidatePairs[i].body, &c = *candidatePairs[i].target;
+                candidateManifolds[i] = CollidesAsWorldPolygons(b.shape, c.shape) ?
+                    CollideWorldPolygons(worldPolygonOf(b), worldPolygonOf(c)) :
+                    b.CollideWith(c);
+            }
+        };
+        const auto collideCircles = [&] (u32 begin, u32 end) {
+            for (u32 k = begin; k < end; ++k) {
+                const Body& b = *candidatePairs[circlePairIndices[k]].body, &c = *candidatePairs[circlePairIndices[k]].target;
+                // circles dont need their rotation
+                circleBatch.SetCircle(k, b.shape.AsUnsafe<CircleShape>(), b.Position(), c.shape.AsUnsafe<CircleShape>(), c.Position());
+            }
+            circleBatch.CollideCircles(begin, end);
+            for (u32 k = begin; k < end; ++k)
+                candidateManifolds[circlePairIndices[k]] = circleBatch.ManifoldAt(k);
+        };
+        const auto collideCircleRects = [&] (u32 begin, u32 end) {
+            for (u32 k = begin; k < end; ++k) {
+                const Body& b = *candidatePairs[circleRectPairIndices[k]].body, &c = *candidatePairs[circleRectPairIndices[k]].target;
+                // the circle is always the base in the batch, the manifold gets flipped back afterwards
+                const bool flip = b.shape.TypeIndex() == IShape::RECT;
+                const Body& circle = flip ? c : b, &rect = flip ? b : c;
+                circleRectBatch.SetRect(k, circle.shape.AsUnsafe<CircleShape>(), circle.GetTransform(), rect.shape.AsUnsafe<RectShape>(), rect.GetTransform());
+            }
+            circleRectBatch.CollideRects(begin, end);
+            for (u32 k = begin; k < end; ++k) {
+                const u32 i = circleRectPairIndices[k];
+                Manifold m = circleRectBatch.ManifoldAt(k);
+                candidateManifolds[i] = candidatePairs[i].body->shape.TypeIndex() == IShape::RECT ? Manifold::Flip(std::move(m)) : m;
+            }
+        };
+        // circle chunks stay whole sets of lanes, so only the very last one falls back to scalar
+        const u32 circleGrain = std::max(narrowphaseGrain / CircleBatch::LANES, 1u) * CircleBatch::LANES;
+        if (threadPool) {
+            threadPool->ParallelFor(otherPairIndices.Length(), narrowphaseGrain, collide);
+            threadPool->ParallelFor(circlePairIndices.Length(), circleGrain, collideCircles);
+            threadPool->ParallelFor(circleRectPairIndices.Length(), circleGrain, collideCircleRects);
+        } else {
+            collide(0, otherPairIndices.Length());
+            collideCircles(0, circlePairIndices.Length());
+            collideCircleRects(0, circleRectPairIndices.Length());
+        }
+
+        // everything with side effects happens in pair order, so results dont depend on thread count
+        for (u32 i = 0; i < candidatePairs.Length(); ++i) {
+            const Manifold& manifold = candidateManifolds[i];
+            if (!manifold.contactCount) continue;
+            ++stats.manifolds;
+            stats.contactPoints += manifold.contactCount;
+
+            Body& b = *candidatePairs[i].body, &c = *candidatePairs[i].target;
+            // anything that gets touched joins the awake body's island
+            if (!b.awake && b.IsDynamic()) b.Wake();
+            if (!c.awake && c.IsDynamic()) c.Wake();
+
+            solver.AddManifold(b, c, manifold);
+        }
+    }
+
+    void World::UpdateSleep(float dt) {
+        islandParents.Clear();
+        for (Body* b : bodies) {
+            if (!b->IsDynamic() || !b->enabled) {
+                // non-dynamic bodies only stay awake to wake what they touch, or while kinematics move
+                b->SetAwake(b->type == BodyType::KINEMATIC && (b->Velocity().LenSq() > 0 || b->AngularVelocity() != 0));
+                continue;
+            }
+
+            b->islandId = islandParents.Length();
+            islandParents.Push(b->islandId);
+            if (!b->awake) continue;
+
+            if (b->Velocity().LenSq() > sleepLinearVelocity * sleepLinearVelocity ||
+                b->AngularVelocity() * b->AngularVelocity() > sleepAngularVelocity * sleepAngularVelocity)
+                b->sleepTime = 0;
+            else b->sleepTime += dt;
+        }
+
+        // union the islands of dynamic bodies in contact
+        for (const ContactConstraint& c : solver.Contacts()) {
+            if (!c.body->IsDynamic() || !c.target->IsDynamic() || !c.body->enabled || !c.target->enabled) continue;
+            const u32 a = FindIsland(c.body->islandId), b = FindIsland(c.target->islandId);
+            if (a != b) islandParents[std::max(a, b)] = std::min(a, b);
+        }
+
+        // an island sleeps once its most restless body could sleep, a woken body wakes everything else
+        islandSleepTime.Clear();
+        islandSleepTime.Resize(islandParents.Length(), f32s::INFINITY);
+        for (Body* b : bodies) {
+            if (!b->IsDynamic() || !b->enabled) continue;
+            float& t = islandSleepTime[FindIsland(b->islandId)];
+            t = std::min(t, b->sleepTime);
+        }
+
+        for (Body* b : bodies) {
+            if (!b->IsDynamic() || !b->enabled) continue;
+            const bool islandSleeps = islandSleepTime[FindIsland(b->islandId)] >= timeToSleep;
+            if (islandSleeps && b->awake) b->Sleep();
+            else if (!islandSleeps && !b->awake) b->Wake();
+        }
+    }
+
+    void World::GatherBullets(float dt) {
+        bulletStarts.Clear();
+        if (!bulletCount) return;
+        for (u32 i = 0; i < bodies.Length(); ++i) {
+            const Body& b = *bodies[i];
+            if (!b.bullet || !b.IsDynamic() || storage.motionScales[i] == 0) continue;
+            // slow bullets are left to the regular contacts
+            const fRect2D& base = storage.baseBoxes[i];
+            const float size = std::min(base.Width(), base.Height());
+            if (storage.velocities[i].Len() * dt < bulletMotionThreshold * size) continue;
+            bulletStarts.Push({ i, { storage.positions[i], storage.rotations[i] } });
+        }
+    }
+
+    void World::SolveBullets(float dt) {
+        for (const BulletStart& start : bulletStarts)
+            AdvanceBullet(*bodies[start.index], start.xf, dt);
+    }
+
+    void World::AdvanceBullet(Body& bullet, PhysicsTransform start, float dt) {
+        const fRect2D& base = bullet.BaseBoundingBox();
+        const float boundRadius = fv2 { std::max(-base.min.x, base.max.x), std::max(-base.min.y, base.max.y) }.Len();
+
+        // everything else has already moved, so bullets are swept against where things ended up
+        float remaining = dt;
+        for (u32 step = 0; step < maxBulletSubSteps; ++step) {
+            const Sweep sweep { start, bullet.Velocity() * remaining, bullet.AngularVelocity() * remaining, boundRadius };
+            const fv2 end = start.position + sweep.translation;
+            const fRect2D sweptBox = fRect2D { fv2::Min(start.position, end), fv2::Max(start.position, end) }.Extrude(boundRadius);
+
+            TimeOfImpactResult first;
+            OptRef<Body> hit = nullptr;
+            QueryAABB(sweptBox, [&] (Body& other) {
+                if (&other == &bullet || (other.bullet && other.IsDynamic())) return true;
+                const TimeOfImpactResult toi = TimeOfImpact(bullet.shape, sweep, other.shape, other.GetTransform(), solver.slop);
+                if (toi.hit && toi.time < first.time) {
+                    first = toi;
+                    hit = other;
+                }
+                return true;
+            });
+
+            if (!hit) {
+                const PhysicsTransform xf = sweep.At(1);
+                bullet.Position() = xf.position;
+                bullet.Rotation() = xf.rotation;
+                break;
+            }
+
+            start = sweep.At(first.time);
+            bullet.Position() = start.position;
+            bullet.Rotation() = start.rotation;
+            remaining *= 1 - first.time;
+            ResolveBulletHit(bullet, *hit, first);
+        }
+        storage.UpdateBox(bullet.index);
+    }
+
+    // a single contact resolved at the time of impact, so the rest of the step slides along the surface
+    void World::ResolveBulletHit(Body& bullet, Body& other, const TimeOfImpactResult& hit) {
+        const fv2 normal = hit.normal;
+        const fv2 relBullet = hit.point - bullet.Position(), relOther = hit.point - other.Position();
+        const bool otherDynamic = other.IsDynamic();
+        const float invMassOther    = otherDynamic ? other.InvMass()    : 0,
+                    invInertiaOther = otherDynamic ? other.InvInertia() : 0;
+
+        const fv2 relVel = (other .Velocity() + relOther .Perpend() * other .AngularVelocity()) -
+                           (bullet.Velocity() + relBullet.Perpend() * bullet.AngularVelocity());
+        const float approach = relVel.Dot(normal);
+        if (approach >= 0) return;
+
+        const float rnBullet = relBullet.Cross(normal), rnOther = relOther.Cross(normal);
+        const float k = bullet.InvMass() + invMassOther +
+                        rnBullet * rnBullet * bullet.InvInertia() +
+                        rnOther  * rnOther  * invInertiaOther;
+        if (k <= 0) return;
+        const fv2 impulse = normal * (-(1 + solver.restitution) * approach / k);
+
+        bullet.Velocity()        -= impulse * bullet.InvMass();
+        bullet.AngularVelocity() -= relBullet.Cross(impulse) * bullet.InvInertia();
+        if (otherDynamic) {
+            other.Velocity()        += impulse * invMassOther;
+            other.AngularVelocity() += relOther.Cross(impulse) * invInertiaOther;
+            other.Wake();
+        }
+    }
+
+    u32 World::FindIsland(u32 i) {
+        while (islandParents[i] != i) {
+            islandParents[i] = islandParents[islandParents[i]];
+            i = islandParents[i];
+        }
+        return i;
+    }
+
     void World::Update(float dt, int simUpdates) {
-        for (int i = 0; i < simUpdates; ++i) {
-            Update(dt / (float)simUpdates);
+        StatsClock::time_point start = StatsClock::now();
+        stats = {};
+        const float subDt = dt / (float)simUpdates;
+        if (!reuseSubstepPairs || simUpdates <= 1) {
+            for (int i = 0; i < simUpdates; ++i) Step(subDt, true);
+        } else {
+            substepPairsStale = true;
+            for (int i = 0; i < simUpdates; ++i) {
+                if (substepPairsStale || !SubstepBoxesHold())
+                    FindSubstepPairs(subDt * (float)(simUpdates - i));
+                Step(subDt, false);
+            }
         }
+        PublishCollisionEvents();
+        FinishStats(Lap(start));
+        CallTriggers();
+    }
+
+    // the parts of a body that don't live in the storage, laid out without padding
+    struct SavedBody {
+        BodyType type;
+        bool enabled, awake, bullet, shapeHasChanged;
+        float mass, inertia, sleepTime;
+        u32 proxyId, islandId;
+    };
+
+    WorldSnapshot World::Snapshot() const {
+        WorldSnapshot snapshot;
+        Snapshot(snapshot);
+        return snapshot;
+    }
+
+    void World::Snapshot(WorldSnapshot& out) const {
+        out.bytes.Clear();
+        out.delta = false;
+        SnapshotWriter w { out.bytes };
+        w.Write(WorldSnapshot::FORMAT_VERSION);
+        w.Write((u32)bodies.Length());
+        w.Write(broadphase);
+        storage.Save(w);
+        for (const Body* b : bodies) {
+            w.Write(SavedBody {
+                b->type, b->enabled, b->awake, b->bullet, b->shapeHasChanged,
+                b->mass, b->inertia, b->sleepTime, b->proxyId, b->islandId
+            });
+            w.WriteShape(b->shape);
+        }
+        // the broadphase structures are saved as they are, rebuilding them could change the pair order
+        tree.Save(w);
+        staticTree.Save(w);
+        w.Write(queryTreeStale);
+        w.WriteSpan(proxyPairs.AsSpan());
+        w.Write(sweepOrderStale);
+        w.WriteSpan(sweepOrder.AsSpan());
+        solver.Save(w);
+    }
+
+    void World::SnapshotDelta(const WorldSnapshot& base, WorldSnapshot& out) {
+        Snapshot(deltaScratch);
+        deltaScratch.MakeDelta(base, out);
+    }
+
+    bool World::Restore(const WorldSnapshot& snapshot) {
+        if (snapshot.IsDelta() || snapshot.IsEmpty()) return false;
+        SnapshotReader in { snapshot.Bytes() };
+        if (in.Read<u32>() != WorldSnapshot::FORMAT_VERSION) return false;
+        const u32 count = in.Read<u32>();
+        broadphase = in.Read<BroadphaseMode>();
+
+        // bodies are matched up by handle, so the ones that exist on both sides keep their objects
+        restoreLookup.Clear();
+        for (u32 i = 0; i < bodies.Length(); ++i) {
+            const u32 id = bodies[i]->handle.id;
+            if (id >= restoreLookup.Length()) restoreLookup.Resize(id + 1, BodyStorage::NULL_INDEX);
+            restoreLookup[id] = i;
+        }
+        std::swap(bodies, restoreBodies);
+
+        const usize storageOffset = in.Offset();
+        storage.Load(in);
+        bulletCount = 0;
+        bool builtBodies = false;
+        for (u32 i = 0; i < count; ++i) {
+            const BodyHandle handle = storage.HandleAt(i);
+            const u32 old = handle.id < restoreLookup.Length() ? restoreLookup[handle.id] : BodyStorage::NULL_INDEX;
+            if (old != BodyStorage::NULL_INDEX && restoreBodies[old]->handle == handle) {
+                bodies.Push(std::move(restoreBodies[old]));
+            } else {
+                bodies.Push(Box<Body>::Build(handle, i, fv2 {}, Rotor2D {}, 0.0f, BodyType::STATIC, *this, Shape {}));
+                builtBodies = true;
+            }
+
+            Body& b = *bodies[i];
+            const SavedBody saved = in.Read<SavedBody>();
+            b.handle          = handle;
+            b.index           = i;
+            b.type            = saved.type;
+            b.enabled         = saved.enabled;
+            b.awake           = saved.awake;
+            b.bullet          = saved.bullet;
+            b.shapeHasChanged = saved.shapeHasChanged;
+            b.mass            = saved.mass;
+            b.inertia         = saved.inertia;
+            b.sleepTime       = saved.sleepTime;
+            b.proxyId         = saved.proxyId;
+            b.islandId        = saved.islandId;
+            in.ReadShape(b.shape);
+            bulletCount += b.bullet;
+        }
+        // anything left over was created after the snapshot
+        restoreBodies.Clear();
+        if (builtBodies) {
+            // building a body writes its defaults into the storage, so read it in again
+            SnapshotReader storageIn { snapshot.Bytes(), storageOffset };
+            storage.Load(storageIn);
+        }
+
+        tree.Load(in, bodies.AsSpan());
+        staticTree.Load(in, bodies.AsSpan());
+        queryTreeStale = in.Read<bool>();
+        in.ReadVec(proxyPairs);
+        proxyPairLookup.Clear();
+        for (u32 i = 0; i < proxyPairs.Length(); ++i)
+            proxyPairLookup.Insert(PairKey(proxyPairs[i].proxyA, proxyPairs[i].proxyB), i);
+        sweepOrderStale = in.Read<bool>();
+        in.ReadVec(sweepOrder);
+        solver.Load(in, bodies.AsSpan());
+
+        grid.Clear();
+        substepPairsStale = true;
+        candidatePairs.Clear();
+        collisionEvents.Clear();
+        return true;
+    }
+
+    bool World::Restore(const WorldSnapshot& delta, const WorldSnapshot& base) {
+        return delta.ApplyDelta(base, deltaScratch) && Restore(deltaScratch);
     }
 
     OptRef<Body> World::BodyAt(usize i) {
@@ -1,11 +1,134 @@
 #pragma once
 #include "Body2D.h"
+#include "CircleBatch2D.h"
+#include "ContactSolver2D.h"
+#include "DynamicTree2D.h"
+#include "Snapshot2D.h"
+#include "SpatialHashGrid2D.h"
+#include "TimeOfImpact2D.h"
+#include "Utils/HashMap.h"
+#include "Utils/ThreadPool.h"
 
 namespace Quasi::Physics2D {
+    enum class BroadphaseMode {
+        SORT_AND_SWEEP,
+        DYNAMIC_TREE,
+        SPATIAL_HASH,
+    };
+
     class World {
     public:
+        struct ProxyPair {
+            u32 proxyA, proxyB;
+        };
+
+        struct BodyPair {
+            Ref<Body> body, target;
+        };
+
+        struct RayCastHit {
+            OptRef<Body> body = nullptr;
+            fv2 point, normal;
+            float fraction = 1;
+        };
+
+        // bodies are named by handle, since they can be deleted before the event is read
+        struct CollisionEvent {
+            BodyHandle body, target;
+            EventType type;
+        };
+
+        // what the last Update did, summed over all of its substeps
+        struct Stats {
+            u32 steps = 0;
+            // milliseconds spent in each phase
+            float integrateMs = 0, broadphaseMs = 0, narrowphaseMs = 0, resolveMs = 0, bulletMs = 0, sleepMs = 0;
+            float totalMs = 0;
+            u32 broadphaseRuns = 0; // fewer than steps when pairs are reused across substeps
+            u32 candidatePairs = 0, manifolds = 0, contactPoints = 0;
+            u32 solvedContacts = 0; // contact constraints handed to the solver
+            u32 solverIslands = 0;  // groups of contacts solved independently, only found with worker threads
+            u32 maxSweepActive = 0; // longest active list seen by sort and sweep
+            u32 awakeBodies = 0;    // as of the end of the update
+            u32 collisionEvents = 0;
+        };
+
+        // bodies[i] always owns the storage slot at dense index i
         Vec<Box<Body>> bodies;
         fv2 gravity;
+
+        bool allowSleep = true;
+        // an island falls asleep once all its bodies stayed under these speeds for timeToSleep seconds
+        float sleepLinearVelocity = 0.5f, sleepAngularVelocity = 0.1f;
+        float timeToSleep = 0.5f;
+
+        // pairs handed to each narrowphase task when running on multiple threads
+        u32 narrowphaseGrain = 64;
+
+        // bullets only get swept once they move further than this fraction of their own size in a step
+        float bulletMotionThreshold = 0.5f;
+        // hits a bullet can bounce off within one step before the rest of its motion is dropped
+        u32 maxBulletSubSteps = 4;
+        // with several sim updates per frame, pairs are found once over boxes covering the whole frame's motion
+        // and only rechecked against the real boxes each substep. the broadphase reruns once a body leaves its box
+        bool reuseSubstepPairs = true;
+        float substepPairMargin = 0.5f;
+        // turns solver contacts into collision events after every update
+        bool reportCollisionEvents = true;
+    private:
+        BodyStorage storage;
+        BroadphaseMode broadphase = BroadphaseMode::SORT_AND_SWEEP;
+        // also serves queries in the other modes, where it is only refit once a query needs it.
+        // only holds bodies that can move, static ones go in their own tree
+        DynamicTree tree;
+        // static bodies dont move during steps, so this is only touched when they are added, removed or teleported
+        DynamicTree staticTree { 0.0f };
+        bool queryTreeStale = false;
+        // pairs whose fat boxes overlap, persisted across steps
+        Vec<ProxyPair> proxyPairs;
+        HashMap<u64, u32> proxyPairLookup;
+        SpatialHashGrid grid;
+        ContactSolver solver;
+        Vec<u32> islandParents;
+        Vec<float> islandSleepTime;
+        // body indices sorted by their box's min x, kept between steps so resorting is cheap
+        Vec<u32> sweepOrder;
+        bool sweepOrderStale = true;
+        Vec<float> sweepKeys;
+        Vec<u32> sweepScratch[3];
+        static constexpr u32 MAX_SWEEP_SHIFTS_PER_BODY = 8;
+
+        Vec<BodyPair> substepPairs;
+        Vec<fRect2D> substepBoxes;
+        bool findingSubstepPairs = false, substepPairsStale = true;
+
+        struct BulletStart {
+            u32 index;
+            PhysicsTransform xf;
+        };
+        u32 bulletCount = 0;
+        Vec<BulletStart> bulletStarts;
+
+        // pairs found by the broadphase this step, and their manifolds in the same order
+        Vec<BodyPair> candidatePairs;
+        Vec<Manifold> candidateManifolds;
+        // world space corners and edge normals of the polygons that have candidates this step, by body index
+        struct WorldPolygonSlot { u32 start = 0, count = 0; };
+        Vec<WorldPolygonSlot> worldPolygonSlots;
+        Vec<fv2> worldPolygonPoints, worldPolygonNormals;
+        // circles against circles and against rects are collided in batches, each keeping the pair indices it came from
+        CircleBatch circleBatch, circleRectBatch;
+        Vec<u32> circlePairIndices, circleRectPairIndices, otherPairIndices;
+
+        Vec<CollisionEvent> collisionEvents;
+
+        // scratch for restoring, kept so rollbacks dont allocate
+        Vec<Box<Body>> restoreBodies;
+        Vec<u32> restoreLookup;
+        WorldSnapshot deltaScratch;
+
+        Stats stats;
+        Box<ThreadPool> threadPool;
     public:
         World() = default;
         World(const fv2& gravity) : gravity(gravity) {}
@@ -16,13 +139,168 @@ namespace Quasi::Physics2D {
 
         Body& CreateBody(const BodyCreateOptions& options, Shape shape);
         Body& CreatePolygon(const BodyCreateOptions& options, Span<const fv2> points);
+        // removal swaps the last body into the hole, so indices of other bodies can change
         void DeleteBody(usize i);
         void DeleteBody(Ref<Body> body);
+        void DeleteBody(BodyHandle handle);
+
+        OptRef<Body> Get(BodyHandle handle);
+        OptRef<const Body> Get(BodyHandle handle) const;
+        const BodyStorage& GetStorage() const { return storage; }
+
+        BroadphaseMode GetBroadphase() const { return broadphase; }
+        const Stats& GetStats() const { return stats; }
+        // what started, kept or stopped touching during the last Update, with ended pairs first.
+        // triggers are called with the same events once the update is done
+        Span<const CollisionEvent> CollisionEvents() const { return collisionEvents.AsSpan(); }
+        void SetBroadphase(BroadphaseMode mode);
+        const DynamicTree& GetDynamicTree() const { return tree; }
+        const DynamicTree& GetStaticTree() const { return staticTree; }
+        void SetTreeMargin(float margin) { tree.margin = margin; }
+        const SpatialHashGrid& GetSpatialHashGrid() const { return grid; }
+        void SetGridCellSize(float cellSize) { grid.SetCellSize(cellSize); }
+        // runs the narrowphase and the solver's islands on this many extra threads, 0 keeps everything on the calling thread
+        void SetWorkerThreads(u32 count);
+        u32 WorkerThreads() const { return threadPool ? threadPool->WorkerCount() : 0; }
+
+        ContactSolver& GetSolver() { return solver; }
+        const ContactSolver& GetSolver() const { return solver; }
 
         void Update(float dt);
         void Update(float dt, int simUpdates);
 
+        // saves everything the simulation depends on, so restoring and stepping again plays out the same.
+        // bodies that exist in both the world and the snapshot keep their objects when restoring,
+        // so references and triggers stay valid. other bodies are deleted or created.
+        WorldSnapshot Snapshot() const;
+        void Snapshot(WorldSnapshot& out) const;
+        // only stores what changed since base, which has to be a full snapshot
+        void SnapshotDelta(const WorldSnapshot& base, WorldSnapshot& out);
+        // false if the snapshot is from another version of the format or is a delta
+        bool Restore(const WorldSnapshot& snapshot);
+        bool Restore(const WorldSnapshot& delta, const WorldSnapshot& base);
+
         OptRef<Body> BodyAt(usize i);
         OptRef<const Body> BodyAt(usize i) const;
+
+        // queries go through the dynamic and static trees, which are kept in every broadphase mode.
+        // outside of tree mode the dynamic tree is only refit when the first query after a step runs.
+        // callbacks return false to stop early, filters return false to skip a body.
+
+        // enabled bodies whose fat box overlaps the box
+        void QueryAABB(const fRect2D& box, Fn<bool, Body&> auto&& callback) {
+            SyncQueryTree();
+            bool keepGoing = true;
+            for (DynamicTree* t : { &tree, &staticTree }) {
+                t->Query(box, [&] (u32 proxy) {
+                    Body& body = t->BodyOf(proxy);
+                    keepGoing = !body.IsEnabled() || callback(body);
+                    return keepGoing;
+                });
+                if (!keepGoing) return;
+            }
+        }
+
+        // enabled bodies whose shape contains the point
+        void QueryPoint(const fv2& point, Fn<bool, Body&> auto&& callback) {
+            const Shape probe = CircleShape { 0.0f };
+            QueryAABB({ point, point }, [&] (Body& body) {
+                return !body.OverlapsWith(probe, point) || callback(body);
+            });
+        }
+
+        // every body the segment hits in no particular order
+        void RayCastAll(const fv2& from, const fv2& to, Fn<bool, const RayCastHit&> auto&& callback) {
+            SyncQueryTree();
+            bool keepGoing = true;
+            for (DynamicTree* t : { &tree, &staticTree }) {
+                t->RayCast(from, to, [&] (u32 proxy, float maxFraction) {
+                    Body& body = t->BodyOf(proxy);
+                    if (!body.IsEnabled()) return maxFraction;
+                    const Option<RayHit> hit = RayCastShape(body.shape, body.GetTransform(), from, to);
+                    keepGoing = !hit || callback(RayCastHit { body, hit->point, hit->normal, hit->fraction });
+                    return keepGoing ? maxFraction : 0.0f;
+                });
+                if (!keepGoing) return;
+            }
+        }
+
+        // the closest body the segment hits
+        Option<RayCastHit> RayCast(const fv2& from, const fv2& to) { return RayCast(from, to, [] (const Body&) { return true; }); }
+        Option<RayCastHit> RayCast(const fv2& from, const fv2& to, Fn<bool, const Body&> auto&& filter) {
+            Option<RayCastHit> closest = nullptr;
+            SyncQueryTree();
+            for (DynamicTree* t : { &tree, &staticTree }) {
+                t->RayCast(from, to, [&] (u32 proxy, float maxFraction) {
+                    Body& body = t->BodyOf(proxy);
+                    if (!body.IsEnabled() || !filter(std::as_const(body))) return maxFraction;
+                    const Option<RayHit> hit = RayCastShape(body.shape, body.GetTransform(), from, to);
+                    if (!hit || hit->fraction >= maxFraction) return maxFraction;
+                    closest = RayCastHit { body, hit->point, hit->normal, hit->fraction };
+                    return hit->fraction;
+                }, closest ? closest->fraction : 1.0f);
+            }
+            return closest;
+        }
+
+        // the first body the shape touches when moved from xf by translation, without rotating.
+        // bodies it already overlaps are skipped.
+        Option<RayCastHit> ShapeCast(const Shape& shape, const PhysicsTransform& xf, const fv2& translation) {
+            return ShapeCast(shape, xf, translation, [] (const Body&) { return true; });
+        }
+        Option<RayCastHit> ShapeCast(const Shape& shape, const PhysicsTransform& xf, const fv2& translation, Fn<bool, const Body&> auto&& filter) {
+            const Sweep sweep { xf, translation };
+            const fRect2D box = xf.TransformRect(shape.ComputeBoundingBox());
+            const fRect2D swept = box.Union({ box.min + translation, box.max + translation });
+
+            Option<RayCastHit> closest = nullptr;
+            QueryAABB(swept, [&] (Body& body) {
+                if (!filter(std::as_const(body))) return true;
+                const TimeOfImpactResult toi = TimeOfImpact(shape, sweep, body.shape, body.GetTransform(), 0);
+                if (toi.hit && (!closest || toi.time < closest->fraction))
+                    closest = RayCastHit { body, toi.point, -toi.normal, toi.time };
+                return true;
+            });
+            return closest;
+        }
+    private:
+        void Step(float dt, bool findPairs);
+        void RunBroadphase();
+        // tests every moving body against the static tree
+        void FindStaticPairs();
+        fRect2D SubstepBox(u32 index, float time) const;
+        void FindSubstepPairs(float time);
+        bool SubstepBoxesHold() const;
+        void CollideSubstepPairs();
+        void FinishStats(float totalMs);
+        void PublishCollisionEvents();
+        void CallTriggers();
+
+        void SortSweepAxis();
+        void RadixSortSweepAxis();
+        void RemoveFromSweep(u32 index);
+        void UpdateSortAndSweep();
+        void UpdateDynamicTree();
+        void UpdateSpatialHash();
+        void FindNewTreePairs();
+        void AddCandidatePair(Body& b, Body& c);
+        void CollideCandidatePairs();
+        void UpdateSleep(float dt);
+        u32 FindIsland(u32 i);
+        void GatherBullets(float dt);
+        void SolveBullets(float dt);
+        void AdvanceBullet(Body& bullet, PhysicsTransform start, float dt);
+        void ResolveBulletHit(Body& bullet, Body& other, const TimeOfImpactResult& hit);
+
+        void CreateProxy(Body& body);
+        void DestroyProxy(Body& body);
+        void RefitProxy(Body& body);
+        DynamicTree& ProxyTreeOf(const Body& body) { return body.IsStatic() ? staticTree : tree; }
+        void SetBodyType(Body& body, BodyType type);
+        void SyncQueryTree();
+
+        static u64 PairKey(u32 a, u32 b) { return a < b ? ((u64)a << 32 | b) : ((u64)b << 32 | a); }
+
+        friend class Body;
     };
 } // Physics
@@ -542,7 +542,7 @@ namespace Quasi {
         OptRef<const Value> operator[](const Key& key) const { return Get(key); }
         OptRef<const Value> Get(const Key& key) const {
             const OptionUsize i = FindIndexOf(key);
-            return i ? kvData[*i].GetValue() : nullptr;
+            return i ? OptRefs::SomeRef(kvData[*i].GetValue()) : nullptr;
         }
         OptRef<const Value> operator[](const auto& kview) const { return Get(kview); }
         OptRef<const Value> Get(const auto& kview) const {
@@ -574,7 +574,7 @@ namespace Quasi {
         }
 
         void NextWhileLessThan(InfoType* info, usize* idx) const {
-            while (*info < info[*idx]) {
+            while (*info < infoData[*idx]) {
                 Next(info, idx);
             }
         }
@@ -806,7 +806,7 @@ namespace Quasi {
             const OptionUsize i = FindIndexOf(k);
             if (!i) return false;
 
-            ShiftDown(i);
+            ShiftDown(*i);
             --elmCount;
             return true;
         }
@@ -834,7 +834,7 @@ namespace Quasi {
             if (!i) return nullptr;
 
             Value val = std::move(kvData[*i].GetValue());
-            ShiftDown(i);
+            ShiftDown(*i);
             --elmCount;
             return val;
         }
@@ -845,7 +845,7 @@ namespace Quasi {
             if (!i) return nullptr;
 
             PairType kvpair = std::move(*kvData[*i]);
-            ShiftDown(i);
+            ShiftDown(*i);
             --elmCount;
             return kvpair;
         }
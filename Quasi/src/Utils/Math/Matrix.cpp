@@ -1,6 +1,12 @@
 ﻿#include "Matrix.h"
 
-#include <xmmintrin.h>
+// sse is always there on x64, and on x86 once msvc is told to use it
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define Q_MATH_SSE 1
+    #include <xmmintrin.h>
+#else
+    #define Q_MATH_SSE 0
+#endif
 
 #include "Transform2D.h"
 #include "Transform3D.h"
@@ -98,19 +104,139 @@ namespace Quasi::Math {
         return m;
     }
 
+#if Q_MATH_SSE
+    // columns arent guaranteed to be 16 byte aligned, so everything loads and stores unaligned
+    static __m128 LoadCol(const fv4& col) { return _mm_loadu_ps(&col.x); }
+    static void StoreCol(fv4& col, __m128 v) { _mm_storeu_ps(&col.x, v); }
+    template <int X, int Y, int Z, int W> static __m128 Shuffle(__m128 a, __m128 b) { return _mm_shuffle_ps(a, b, X | Y << 2 | Z << 4 | W << 6); }
+    template <int X, int Y, int Z, int W> static __m128 Swizzle(__m128 a) { return Shuffle<X, Y, Z, W>(a, a); }
+    template <int I> static __m128 Splat(__m128 a) { return Shuffle<I, I, I, I>(a, a); }
+
+    // sums the columns scaled by each component of v, in the same order as the generic loops
+    static __m128 CombineCols(const __m128 (&cols)[4], __m128 v) {
+        __m128 r = _mm_mul_ps(cols[0], Splat<0>(v));
+        r = _mm_add_ps(r, _mm_mul_ps(cols[1], Splat<1>(v)));
+        r = _mm_add_ps(r, _mm_mul_ps(cols[2], Splat<2>(v)));
+        return _mm_add_ps(r, _mm_mul_ps(cols[3], Splat<3>(v)));
+    }
+
+    // 2x2 matrices packed as (a, b, c, d), read row by row
+    static __m128 Mat2Mul(__m128 a, __m128 b) {
+        return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)),
+                          _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+    }
+    // adj(a) * b
+    static __m128 Mat2AdjMul(__m128 a, __m128 b) {
+        return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b),
+                          _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+    }
+    // a * adj(b)
+    static __m128 Mat2MulAdj(__m128 a, __m128 b) {
+        return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)),
+                          _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+    }
+#endif
+
     Matrix<4> Matrix<4>::Transpose() const {
+#if Q_MATH_SSE
         // https://stackoverflow.com/a/16743203
         Matrix result { Uninit };
-        __m128 row1 = _mm_load_ps(&unitVectors[0][0]);
-        __m128 row2 = _mm_load_ps(&unitVectors[1][0]);
-        __m128 row3 = _mm_load_ps(&unitVectors[2][0]);
-        __m128 row4 = _mm_load_ps(&unitVectors[3][0]);
+        __m128 row1 = LoadCol(unitVectors[0]);
+        __m128 row2 = LoadCol(unitVectors[1]);
+        __m128 row3 = LoadCol(unitVectors[2]);
+        __m128 row4 = LoadCol(unitVectors[3]);
         _MM_TRANSPOSE4_PS(row1, row2, row3, row4);
-        _mm_store_ps(&result.unitVectors[0][0], row1);
-        _mm_store_ps(&result.unitVectors[1][0], row2);
-        _mm_store_ps(&result.unitVectors[2][0], row3);
-        _mm_store_ps(&result.unitVectors[3][0], row4);
+        StoreCol(result.unitVectors[0], row1);
+        StoreCol(result.unitVectors[1], row2);
+        StoreCol(result.unitVectors[2], row3);
+        StoreCol(result.unitVectors[3], row4);
+        return result;
+#else
+        return IMatrix::Transpose();
+#endif
+    }
+
+    Matrix<4> Matrix<4>::Mul(const Matrix& other) const {
+#if Q_MATH_SSE
+        const __m128 cols[4] = { LoadCol(unitVectors[0]), LoadCol(unitVectors[1]), LoadCol(unitVectors[2]), LoadCol(unitVectors[3]) };
+        Matrix result { Uninit };
+        for (usize i = 0; i < 4; ++i)
+            StoreCol(result.unitVectors[i], CombineCols(cols, LoadCol(other.unitVectors[i])));
+        return result;
+#else
+        return IMatrix::Mul(other);
+#endif
+    }
+
+    fv4 Matrix<4>::TransformLinear(const fv4& vector) const {
+#if Q_MATH_SSE
+        const __m128 cols[4] = { LoadCol(unitVectors[0]), LoadCol(unitVectors[1]), LoadCol(unitVectors[2]), LoadCol(unitVectors[3]) };
+        fv4 result;
+        StoreCol(result, CombineCols(cols, LoadCol(vector)));
+        return result;
+#else
+        return IMatrix::TransformLinear(vector);
+#endif
+    }
+
+    fv3 Matrix<4>::Transform(const fv3& vector) const {
+#if Q_MATH_SSE
+        // translation gets added last, same as the generic version
+        __m128 r = _mm_mul_ps(LoadCol(unitVectors[0]), _mm_set1_ps(vector.x));
+        r = _mm_add_ps(r, _mm_mul_ps(LoadCol(unitVectors[1]), _mm_set1_ps(vector.y)));
+        r = _mm_add_ps(r, _mm_mul_ps(LoadCol(unitVectors[2]), _mm_set1_ps(vector.z)));
+        r = _mm_add_ps(r, LoadCol(unitVectors[3]));
+        fv4 result;
+        StoreCol(result, r);
+        return result.As3D();
+#else
+        return IMatrix::Transform(vector);
+#endif
+    }
+
+    Matrix<4> Matrix<4>::Inverse() const {
+#if Q_MATH_SSE
+        // inverting by 2x2 blocks, https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+        // it doesnt matter that these are columns, since the inverse of the transpose is the transpose of the inverse
+        const __m128 c0 = LoadCol(unitVectors[0]), c1 = LoadCol(unitVectors[1]),
+                     c2 = LoadCol(unitVectors[2]), c3 = LoadCol(unitVectors[3]);
+        const __m128 a = _mm_movelh_ps(c0, c1), b = _mm_movehl_ps(c1, c0),
+                     c = _mm_movelh_ps(c2, c3), d = _mm_movehl_ps(c3, c2);
+
+        // determinants of a, b, c and d
+        const __m128 detSub = _mm_sub_ps(_mm_mul_ps(Shuffle<0, 2, 0, 2>(c0, c2), Shuffle<1, 3, 1, 3>(c1, c3)),
+                                         _mm_mul_ps(Shuffle<1, 3, 1, 3>(c0, c2), Shuffle<0, 2, 0, 2>(c1, c3)));
+        const __m128 detA = Splat<0>(detSub), detB = Splat<1>(detSub),
+                     detC = Splat<2>(detSub), detD = Splat<3>(detSub);
+
+        const __m128 dc = Mat2AdjMul(d, c), ab = Mat2AdjMul(a, b);
+        __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Mat2Mul(b, dc)),
+               w = _mm_sub_ps(_mm_mul_ps(detA, d), Mat2Mul(c, ab)),
+               y = _mm_sub_ps(_mm_mul_ps(detB, c), Mat2MulAdj(d, ab)),
+               z = _mm_sub_ps(_mm_mul_ps(detC, b), Mat2MulAdj(a, dc));
+
+        // |m| = |a||d| + |b||c| - tr(adj(a) b adj(d) c)
+        __m128 tr = _mm_mul_ps(ab, Swizzle<0, 2, 1, 3>(dc));
+        tr = _mm_add_ps(tr, Swizzle<1, 0, 3, 2>(tr));
+        tr = _mm_add_ps(tr, Swizzle<2, 3, 0, 1>(tr));
+        const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+        const __m128 invDet = _mm_div_ps(_mm_setr_ps(1, -1, -1, 1), det);
+        x = _mm_mul_ps(x, invDet);
+        y = _mm_mul_ps(y, invDet);
+        z = _mm_mul_ps(z, invDet);
+        w = _mm_mul_ps(w, invDet);
+
+        // undo the adjugates while putting the blocks back together
+        Matrix result { Uninit };
+        StoreCol(result.unitVectors[0], Shuffle<3, 1, 3, 1>(x, y));
+        StoreCol(result.unitVectors[1], Shuffle<2, 0, 2, 0>(x, y));
+        StoreCol(result.unitVectors[2], Shuffle<3, 1, 3, 1>(z, w));
+        StoreCol(result.unitVectors[3], Shuffle<2, 0, 2, 0>(z, w));
         return result;
+#else
+        return IMatrix::Inverse();
+#endif
     }
 
     Matrix<4> Matrix<4>::Rotation(const Rotor3D& rotation) {
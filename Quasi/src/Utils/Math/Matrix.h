@@ -360,7 +360,20 @@ namespace Quasi::Math {
 
     template <> struct Matrix<4, 4> : IMatrix<4, 4> {
         using IMatrix::IMatrix;
+        using IMatrix::Mul;
+        using IMatrix::operator*;
+
+        // these use sse when it's available, and the generic versions otherwise.
+        // Mul and the transforms give the same results as the generic ones, Inverse only to within rounding
         Matrix Transpose() const;
+        Matrix Mul(const Matrix& other) const;
+        Matrix Inverse() const;
+        fv4 TransformLinear(const fv4& vector) const;
+        fv3 Transform(const fv3& vector) const;
+
+        Matrix operator*(const Matrix& other) const { return Mul(other); }
+        fv4 operator*(const fv4& vector) const { return TransformLinear(vector); }
+        fv3 operator*(const fv3& vector) const { return Transform(vector); }
 
         static Matrix Rotation(const Rotor3D& rotation);
         Matrix& RotateBy(const Rotor3D& rotation);
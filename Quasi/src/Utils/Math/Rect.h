@@ -44,7 +44,7 @@ namespace Quasi::Math {
         static Rect FromCenter(const VecT& center, const VecT& size) { return { center - size, center + size, Inclusive }; }
         static Rect Empty()      { return {}; }
         static Rect FullDomain() { return { NumInfo<T>::MIN, NumInfo<T>::MAX }; }
-        static Rect AntiDomain() { return { NumInfo<T>::MIN, NumInfo<T>::MAX }; }
+        static Rect AntiDomain() { return { NumInfo<T>::MAX, NumInfo<T>::MIN }; }
         static Rect On(const VecT& point) { return { point, point, Inclusive }; }
         static Rect Over(const Collection<VecT> auto& nums) {
             Rect r = AntiDomain();
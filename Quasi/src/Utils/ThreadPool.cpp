@@ -0,0 +1,67 @@
+#include "ThreadPool.h"
+
+namespace Quasi {
+    ThreadPool::ThreadPool(u32 workerCount) {
+        workers.Reserve(workerCount);
+        for (u32 i = 0; i < workerCount; ++i)
+            workers.Push(std::thread { [this] { WorkerLoop(); } });
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock { mutex };
+            stopping = true;
+        }
+        jobStarted.notify_all();
+        for (std::thread& w : workers) w.join();
+    }
+
+    u32 ThreadPool::AvailableWorkers() {
+        const u32 hw = std::thread::hardware_concurrency();
+        return hw > 1 ? hw - 1 : 0;
+    }
+
+    void ThreadPool::Run(u32 count, u32 grain, FuncRef<void(u32, u32)> fn) {
+        {
+            std::lock_guard lock { mutex };
+            job = fn;
+            jobSize = count;
+            jobGrain = grain ? grain : 1;
+            nextIndex = 0;
+            busyWorkers = workers.Length();
+            ++generation;
+        }
+        jobStarted.notify_all();
+
+        RunChunks();
+
+        std::unique_lock lock { mutex };
+        jobFinished.wait(lock, [this] { return busyWorkers == 0; });
+        job = nullptr;
+    }
+
+    void ThreadPool::RunChunks() {
+        while (true) {
+            const u32 begin = nextIndex.fetch_add(jobGrain, std::memory_order_relaxed);
+            if (begin >= jobSize) return;
+            job(begin, std::min(begin + jobGrain, jobSize));
+        }
+    }
+
+    void ThreadPool::WorkerLoop() {
+        u64 seenGeneration = 0;
+        while (true) {
+            {
+                std::unique_lock lock { mutex };
+                jobStarted.wait(lock, [&] { return stopping || generation != seenGeneration; });
+                if (stopping) return;
+                seenGeneration = generation;
+            }
+
+            RunChunks();
+
+            std::lock_guard lock { mutex };
+            if (--busyWorkers == 0) jobFinished.notify_one();
+        }
+    }
+} // Quasi
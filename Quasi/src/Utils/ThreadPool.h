@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "Func.h"
+#include "Vec.h"
+
+namespace Quasi {
+    // fixed set of worker threads, which split index ranges between themselves and the calling thread.
+    // only one job runs at a time, and ParallelFor blocks until it finishes.
+    class ThreadPool {
+        Vec<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable jobStarted, jobFinished;
+
+        FuncRef<void(u32, u32)> job = nullptr;
+        u32 jobSize = 0, jobGrain = 1;
+        std::atomic<u32> nextIndex = 0;
+        u32 busyWorkers = 0;
+        u64 generation = 0;
+        bool stopping = false;
+    public:
+        explicit ThreadPool(u32 workerCount);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // number of threads available besides the calling one
+        static u32 AvailableWorkers();
+        u32 WorkerCount() const { return workers.Length(); }
+
+        // calls fn(begin, end) for chunks of at most grain indices covering [0, count)
+        void ParallelFor(u32 count, u32 grain, Fn<void, u32, u32> auto&& fn) {
+            if (workers.IsEmpty() || count <= grain) {
+                if (count) fn(0, count);
+                return;
+            }
+            auto call = [&] (u32 begin, u32 end) { fn(begin, end); };
+            Run(count, grain, call);
+        }
+    private:
+        void Run(u32 count, u32 grain, FuncRef<void(u32, u32)> fn);
+        void RunChunks();
+        void WorkerLoop();
+    };
+} // Quasi
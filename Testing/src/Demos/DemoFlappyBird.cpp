@@ -42,7 +42,7 @@ namespace Test {
 
         if (isEnd) {
             if (!completedDeathAnim) {
-                const Math::fv2 playerCenter = playerBody->position;
+                const Math::fv2 playerCenter = playerBody->Position();
                 world.DeleteBody(*playerBody);
 
                 for (u32 i = 0; i < 10; ++i)
@@ -55,7 +55,7 @@ namespace Test {
         }
 
         if (gdevice.GetIO().Keyboard.KeyOnPress(IO::Key::SPACE)) {
-            playerBody->velocity.y = 250;
+            playerBody->Velocity().y = 250;
         }
 
         score = (int)(gdevice.GetIO().Time.currentTime - time);
@@ -83,14 +83,14 @@ namespace Test {
         const Math::fColor playerColor = isEnd ? Math::fColor::Better::Red() : Math::fColor::Better::White();
         for (const auto& body : world.bodies) {
             if (const auto tri = body->shape.As<Physics2D::StaticPolygonShape>()) {
-                spikeMesh.vertices[0].Position = tri->points[0] + body->position;
-                spikeMesh.vertices[1].Position = tri->points[1] + body->position;
-                spikeMesh.vertices[2].Position = tri->points[2] + body->position;
+                spikeMesh.vertices[0].Position = tri->points[0] + body->Position();
+                spikeMesh.vertices[1].Position = tri->points[1] + body->Position();
+                spikeMesh.vertices[2].Position = tri->points[2] + body->Position();
                 scene.AddMesh(spikeMesh);
             } else if (const auto p = body->shape.As<Physics2D::CircleShape>()) {
                 scene.AddMeshB(Meshes::Circle(p->radius),
                     [&] (const Vertex2D& v) {
-                        return Vertex { v.Position + body->position, playerColor, 0, 0 };
+                        return Vertex { v.Position + body->Position(), playerColor, 0, 0 };
                     });
             }
         }
@@ -133,10 +133,16 @@ namespace Test {
             SetObstacle(world.CreatePolygon({ { 370.0f, 0.0f }, 0, Physics2D::BodyType::STATIC }, bot.points));
         }
 
+        // spikes are static, so teleport them to keep their boxes in the static tree up to date
+        const float scroll = 150 * gdevice.GetIO().Time.DeltaTime();
         for (auto& spike : world.bodies) {
             if (spike->shape.Is<Physics2D::StaticPolygonShape>())
-                spike->position.x -= 150 * gdevice.GetIO().Time.DeltaTime();
+                spike->Teleport(spike->Position() - Math::fv2 { scroll, 0 });
+        }
+        // deleting swaps the last body in, so walk backwards to see every body once
+        for (usize i = world.BodyCount(); i > 0; --i) {
+            if (world.bodies[i - 1]->Position().x <= -370.0f)
+                world.DeleteBody(i - 1);
         }
-        world.bodies.Keep([] (const Box<Physics2D::Body>& bod) { return bod->position.x > -370.0f; });
     }
 }
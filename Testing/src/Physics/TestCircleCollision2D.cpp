@@ -46,13 +46,13 @@ namespace Test {
         if (mouse.LeftOnPress() && !selected) {
             selected = FindBallAt(mousePos);
             if (selected)
-                selectOffset = mousePos - selected->position;
+                selectOffset = mousePos - selected->Position();
         }
 
         if (mouse.LeftPressed() && selected) {
             const Math::fv2 newPos = mousePos - selectOffset;
-            selected->position = newPos;
-            selected->velocity = 0;
+            selected->Teleport(newPos);
+            selected->Velocity() = 0;
         }
 
         if (mouse.LeftOnRelease()) selected = nullptr;
@@ -63,13 +63,13 @@ namespace Test {
         }
 
         if (mouse.RightPressed() && selected) {
-            totalLineMesh.vertices[8].Position = selected->position;
+            totalLineMesh.vertices[8].Position = selected->Position();
             totalLineMesh.vertices[9].Position = mousePos;
         }
 
         if (mouse.RightOnRelease() && selected && selected->IsDynamic()) {
             const bool scale = gdevice.GetIO().Keyboard.KeyPressed(IO::Key::LCONTROL);
-            selected->velocity -= (scale ? 10.0f : 1.0f) * (mousePos - selected->position);
+            selected->AddVelocity(-(scale ? 10.0f : 1.0f) * (mousePos - selected->Position()));
             totalLineMesh.vertices[8].Position = 0;
             totalLineMesh.vertices[9].Position = 0;
             selected = nullptr;
@@ -77,13 +77,13 @@ namespace Test {
 
         {
             // [[maybe_unused]] Timer t { "PhysicsUpdate", Debug::Logger::InternalLog };
-            world.Update(deltaTime, 32);
+            world.Update(deltaTime, 4);
         }
 
         for (int i = 0; i < 4; ++i) {
             auto r = edge[i]->shape.As<Physics2D::RectShape>();
-            totalLineMesh.vertices[2 * i + 0].Position = r->Corner(i == 0, i == 2) + edge[i]->position;
-            totalLineMesh.vertices[2 * i + 1].Position = r->Corner(i != 1, i != 3) + edge[i]->position;
+            totalLineMesh.vertices[2 * i + 0].Position = r->Corner(i == 0, i == 2) + edge[i]->Position();
+            totalLineMesh.vertices[2 * i + 1].Position = r->Corner(i != 1, i != 3) + edge[i]->Position();
         }
 
         lineShader.Bind();
@@ -100,7 +100,7 @@ namespace Test {
         for (auto& body : world.bodies) {
             if (body->shape.Is<Physics2D::RectShape>()) continue;
             if (selectedIndex == -1 && selected && selected.RefEquals(body.AsRef())) selectedIndex = (int)i;
-            offsets[i] = body->position;
+            offsets[i] = body->Position();
             scales[i] = body->shape.As<Physics2D::CircleShape>()->radius;
             colors[i] = Math::fColor::FromHSV(
                 Math::Clamp(fRange { 0, 80.0f }.MapTo(offsets[i].x, { 0, 1 }), 0.0f, 1.0f),
@@ -54,7 +54,7 @@ namespace Test {
                 if (controlIndex == ~0) {
                     if (const auto s = FindAt(mousePos); s != ~0) {
                         Select(s);
-                        selectOffset = Selected()->body->position - mousePos;
+                        selectOffset = Selected()->body->Position() - mousePos;
                     } else Unselect();
                 }
             }
@@ -62,7 +62,7 @@ namespace Test {
                 if (controlIndex != ~0) {
                     EditControl(mousePos);
                 } else if (selectedIndex != ~0) {
-                    Selected()->body->position = mousePos + selectOffset;
+                    Selected()->body->Teleport(mousePos + selectOffset);
                 }
             }
 
@@ -92,7 +92,7 @@ namespace Test {
 
         worldUpdate:
         if (onPause & 1) return;
-        world.Update(std::min(deltaTime, 1 / 60.0f), 32);
+        world.Update(std::min(deltaTime, 1 / 60.0f), 4);
         onPause = onPause == 2 ? 1 : 0;
     }
 
@@ -148,7 +148,7 @@ namespace Test {
                         poly.data.Iter()
                                  .Map(Operators::Member<&Physics2D::DynPolygonShape::PPoint::pos> {})
                                  .Map([&] (const Math::fv2& p) {
-                                        return Vertex { body->rotation.Rotate(p) + body->position, color };
+                                        return Vertex { body->Rotation().Rotate(p) + body->Position(), color };
                         })
                     );
                 }
@@ -170,7 +170,7 @@ namespace Test {
         }
 
         if (selectedIndex != ~0) {
-            AddNewPoint(Selected()->body->position, fColor::Red());
+            AddNewPoint(Selected()->body->Position(), fColor::Red());
         }
 
         DrawControlPoints();
@@ -213,10 +213,18 @@ namespace Test {
             ImGui::Text("Type: %s", SHAPE_NAMES[Selected()->body->shape.GetTag()]);
 
             EditBody();
-            ImGui::EditRotation2D("Rotation", Selected()->body->rotation);
+            // static bodies only refit their proxy when teleported, so edit a copy
+            Math::Rotor2D rotation = Selected()->body->Rotation();
+            ImGui::EditRotation2D("Rotation", rotation);
+            if (!rotation.AsUnitVector().InRange(Selected()->body->Rotation().AsUnitVector(), 1e-6f))
+                Selected()->body->Teleport(Selected()->body->Position(), rotation);
+            Selected()->body->Wake();
             float m = Selected()->body->mass;
             ImGui::EditScalar("Mass", m, 1, fRange { 0, f32s::INFINITY });
             Selected()->body->SetMass(m);
+            bool bullet = Selected()->body->IsBullet();
+            ImGui::Checkbox("Bullet", &bullet);
+            Selected()->body->SetBullet(bullet);
             ImGui::EditColor ("Tint", Selected()->color);
 
             if (ImGui::Button("Delete")) {
@@ -236,7 +244,13 @@ namespace Test {
             onPause += ImGui::Button("Step");
         }
 
+        int broadphase = (int)world.GetBroadphase();
+        if (ImGui::Combo("Broadphase", &broadphase, "Sort and Sweep\0Dynamic Tree\0Spatial Hash\0\0"))
+            world.SetBroadphase((Physics2D::BroadphaseMode)broadphase);
+        ImGui::Checkbox("Reuse Substep Pairs", &world.reuseSubstepPairs);
+
         ImGui::Text("Total Body Count: %d", bodyData.Length());
+        ImGui::DisplayPhysicsStats("Physics Stats", world);
     }
 
     void TestPhysicsPlayground2D::OnDestroy(Graphics::GraphicsDevice& gdevice) {
@@ -248,16 +262,15 @@ namespace Test {
         selectedIndex = toSelect;
         if (selectedIndex != ~0) {
             selectedIsStatic = Selected()->body->IsStatic();
-            Selected()->body->type = Physics2D::BodyType::STATIC;
-            Selected()->body->velocity = 0;
-            Selected()->body->angularVelocity = 0;
+            Selected()->body->SetType(Physics2D::BodyType::STATIC);
+            Selected()->body->Stop();
             addedVelocity = 0;
         }
     }
 
     void TestPhysicsPlayground2D::Unselect() {
         if (selectedIndex != ~0 && !selectedIsStatic) {
-            Selected()->body->type = Physics2D::BodyType::DYNAMIC;
+            Selected()->body->SetType(Physics2D::BodyType::DYNAMIC);
             Selected()->body->AddVelocityAt(forceAddedPosition, addedVelocity * Selected()->body->mass);
         }
         selectedIndex = ~0;
@@ -278,15 +291,15 @@ namespace Test {
         meshp.PushI(1, 2, 3);
     }
 
-    u32 TestPhysicsPlayground2D::FindAt(const Math::fv2& mousePos) const {
-        const Physics2D::Shape mouseCollider = Physics2D::CircleShape { 0.0f };
-        for (u32 i = 0; i < bodyData.Length(); ++i) {
-            const auto& b = bodyData[i];
-            if (b.body->OverlapsWith(mouseCollider, mousePos)) {
-                return i;
+    u32 TestPhysicsPlayground2D::FindAt(const Math::fv2& mousePos) {
+        u32 found = ~0;
+        world.QueryPoint(mousePos, [&] (Physics2D::Body& body) {
+            for (u32 i = 0; i < bodyData.Length(); ++i) {
+                if (bodyData[i].body.RefEquals(body)) { found = i; break; }
             }
-        }
-        return ~0;
+            return false;
+        });
+        return found;
     }
 
     void TestPhysicsPlayground2D::AddBodyTint(const Math::fColor& color) {
@@ -382,8 +395,8 @@ namespace Test {
 
     void TestPhysicsPlayground2D::EditControlPoint(const Math::fv2& mouse, Math::fv2& control, u32 i) {
         if (controlIndex != i) return;
-        const Math::fv2& origin = Selected()->body->position;
-        const Math::Rotor2D& rotation = Selected()->body->rotation;
+        const Math::fv2& origin = Selected()->body->Position();
+        const Math::Rotor2D& rotation = Selected()->body->Rotation();
         control = rotation.InvRotate(mouse + controlOffset - origin);
     }
 
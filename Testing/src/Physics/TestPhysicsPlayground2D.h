@@ -47,7 +47,7 @@ namespace Test {
 
         OptRef<Object> Selected();
         void AddNewPoint(const Math::fv2& point, const Math::fColor& color);
-        u32 FindAt(const Math::fv2& mousePos) const;
+        u32 FindAt(const Math::fv2& mousePos);
         void AddBodyTint(const Math::fColor& color);
 
         void SelectControl(const Math::fv2& mouse);